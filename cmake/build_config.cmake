@@ -10,4 +10,11 @@ add_compile_options(
 )
 
 set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
-set(CMAKE_VERBOSE_MAKEFILE ON)
\ No newline at end of file
+set(CMAKE_VERBOSE_MAKEFILE ON)
+
+# The vectorised kernels are only compiled with AVX2 enabled. It is off by default,
+# so a default build runs on any x86-64 machine.
+option(AOC_ENABLE_AVX2 "Compile the AVX2 code paths" OFF)
+if(AOC_ENABLE_AVX2)
+  add_compile_options(-mavx2)
+endif()
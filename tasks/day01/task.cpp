@@ -1,9 +1,25 @@
 #include <catch2/catch_all.hpp>
-#include <set>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/FenwickTree.h>
+#include <utils/MappedFile.h>
+#include <utils/Parallel.h>
+#include <array>
+#include <utility>
+#include <vector>
 #include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <numeric>
+#include <random>
+#include <charconv>
+#include <cctype>
+#include <string_view>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 constexpr auto testData = R"(3   4
 4   3
@@ -12,9 +28,40 @@ constexpr auto testData = R"(3   4
 3   9
 3   3)";
 
-using DataColumn = std::multiset<uint32_t>;
+using DataColumn = std::vector<uint32_t>;
 using DataColumns = std::pair<DataColumn, DataColumn>;
 
+// LSD radix sort with 11-bit digits, three counting passes cover the whole uint32_t.
+void RadixSort(DataColumn &values)
+{
+  constexpr uint32_t digitBits = 11;
+  constexpr uint32_t buckets = 1u << digitBits;
+  constexpr uint32_t mask = buckets - 1;
+
+  DataColumn buffer(values.size());
+
+  for (uint32_t shift = 0; shift < 32; shift += digitBits)
+  {
+    std::array<size_t, buckets> offsets{};
+    for (const auto value : values)
+    {
+      ++offsets[(value >> shift) & mask];
+    }
+
+    size_t offset = 0;
+    for (auto &count : offsets)
+    {
+      offset += std::exchange(count, offset);
+    }
+
+    for (const auto value : values)
+    {
+      buffer[offsets[(value >> shift) & mask]++] = value;
+    }
+    values.swap(buffer);
+  }
+}
+
 DataColumns ReadColumns(std::istream &input)
 {
   DataColumn left;
@@ -25,27 +72,360 @@ DataColumns ReadColumns(std::istream &input)
 
   while (input >> lval >> rval)
   {
-    left.insert(lval);
-    right.insert(rval);
+    left.push_back(lval);
+    right.push_back(rval);
+  }
+
+  RadixSort(left);
+  RadixSort(right);
+
+  return {std::move(left), std::move(right)};
+}
+
+// |a - b| summed into 64-bit accumulators. With AVX2 eight lanes are processed at once
+// and each half of the differences is widened into four 64-bit partial sums.
+uint64_t SumDistances(const DataColumn &left, const DataColumn &right)
+{
+  const size_t size = std::min(left.size(), right.size());
+  size_t i = 0;
+  uint64_t sum = 0;
+
+#if defined(__AVX2__)
+  __m256i partialSums = _mm256_setzero_si256();
+  for (; i + 8 <= size; i += 8)
+  {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(left.data() + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right.data() + i));
+    const __m256i diff = _mm256_sub_epi32(_mm256_max_epu32(a, b), _mm256_min_epu32(a, b));
+
+    partialSums = _mm256_add_epi64(partialSums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(diff)));
+    partialSums = _mm256_add_epi64(partialSums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(diff, 1)));
+  }
+
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), partialSums);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; i < size; ++i)
+  {
+    sum += std::max(left[i], right[i]) - std::min(left[i], right[i]);
+  }
+  return sum;
+}
+
+// Both columns are sorted, so every distinct value is visited once as a pair of runs
+// and contributes value * left run length * right run length.
+uint64_t CalculateSimilarity(const DataColumn &left, const DataColumn &right)
+{
+  uint64_t similarity = 0;
+  size_t l = 0;
+  size_t r = 0;
+
+  while (l < left.size() && r < right.size())
+  {
+    if (left[l] < right[r])
+    {
+      ++l;
+    }
+    else if (right[r] < left[l])
+    {
+      ++r;
+    }
+    else
+    {
+      const uint32_t value = left[l];
+      const size_t leftRunStart = l;
+      const size_t rightRunStart = r;
+      while (l < left.size() && left[l] == value)
+      {
+        ++l;
+      }
+      while (r < right.size() && right[r] == value)
+      {
+        ++r;
+      }
+      similarity += uint64_t(value) * (l - leftRunStart) * (r - rightRunStart);
+    }
+  }
+  return similarity;
+}
+
+// Histogram variant for columns whose values are known to be at most maxValue, it
+// does not need sorted input.
+uint64_t CalculateSimilarityWithHistogram(const DataColumn &left, const DataColumn &right, uint32_t maxValue)
+{
+  if (std::ranges::any_of(left, [=](uint32_t value)
+                          { return value > maxValue; }) ||
+      std::ranges::any_of(right, [=](uint32_t value)
+                          { return value > maxValue; }))
+  {
+    throw std::out_of_range("Location id outside of the value domain");
+  }
+
+  std::vector<uint32_t> rightCounts(static_cast<size_t>(maxValue) + 1, 0);
+  for (const auto value : right)
+  {
+    ++rightCounts[value];
+  }
+
+  return std::accumulate(left.begin(), left.end(), uint64_t(0), [&rightCounts](auto acc, const auto &val)
+                         { return acc + uint64_t(val) * rightCounts[val]; });
+}
+
+// Keeps both answers current while pairs keep arriving, using Fenwick trees of value
+// counts over the bounded value domain. The distance relies on
+// sum_k |l_k - r_k| = sum_x |L(x) - R(x)|, where L(x) and R(x) count the values <= x,
+// so a new pair only changes the terms between its two values.
+class IncrementalLocationLists
+{
+public:
+  explicit IncrementalLocationLists(uint32_t maxValue)
+      : left(size_t(maxValue) + 1), right(size_t(maxValue) + 1), all(size_t(maxValue) + 1) {}
+
+  void Insert(uint32_t lval, uint32_t rval)
+  {
+    if (lval >= left.Size() || rval >= right.Size())
+    {
+      throw std::out_of_range("Location id outside of the value domain");
+    }
+
+    const auto [low, high] = std::minmax(lval, rval);
+    distance -= SumCountDifferences(low, high);
+
+    similarity += uint64_t(lval) * right.At(lval);
+    left.Add(lval, 1);
+    all.Add(lval, 1);
+    similarity += uint64_t(rval) * left.At(rval);
+    right.Add(rval, 1);
+    all.Add(rval, 1);
+
+    distance += SumCountDifferences(low, high);
+  }
+
+  void InsertPairs(std::istream &input)
+  {
+    uint32_t lval = 0;
+    uint32_t rval = 0;
+
+    while (input >> lval >> rval)
+    {
+      Insert(lval, rval);
+    }
+  }
+
+  uint64_t GetDistance() const
+  {
+    return distance;
+  }
+
+  uint64_t GetSimilarity() const
+  {
+    return similarity;
+  }
+
+private:
+  // Sum of |L(x) - R(x)| for x in [first, last), jumping between present values.
+  uint64_t SumCountDifferences(size_t first, size_t last) const
+  {
+    uint64_t sum = 0;
+    for (size_t x = first; x < last;)
+    {
+      const size_t next = std::min(all.UpperBound(all.PrefixSum(x)), last);
+      const int64_t difference = left.PrefixSum(x) - right.PrefixSum(x);
+      sum += static_cast<uint64_t>(std::abs(difference)) * (next - x);
+      x = next;
+    }
+    return sum;
+  }
+
+  FenwickTree<int64_t> left;
+  FenwickTree<int64_t> right;
+  FenwickTree<int64_t> all;
+  uint64_t distance = 0;
+  uint64_t similarity = 0;
+};
+
+// Parses the pairs of a byte range, the range has to start at the beginning of a line.
+DataColumns ParseColumns(std::string_view text)
+{
+  DataColumn left;
+  DataColumn right;
+
+  const char *position = text.data();
+  const char *end = text.data() + text.size();
+
+  auto skipSpaces = [&]
+  {
+    while (position != end && std::isspace(static_cast<unsigned char>(*position)))
+    {
+      ++position;
+    }
+  };
+
+  while (true)
+  {
+    uint32_t lval = 0;
+    uint32_t rval = 0;
+
+    skipSpaces();
+    auto result = std::from_chars(position, end, lval);
+    if (result.ec != std::errc())
+    {
+      break;
+    }
+    position = result.ptr;
+
+    skipSpaces();
+    result = std::from_chars(position, end, rval);
+    if (result.ec != std::errc())
+    {
+      break;
+    }
+    position = result.ptr;
+
+    left.push_back(lval);
+    right.push_back(rval);
   }
 
-  return {left, right};
+  return {std::move(left), std::move(right)};
 }
 
-uint32_t SumDistances(const DataColumn &left, const DataColumn &right)
+// Splits the input at line boundaries, then every worker parses and radix sorts its
+// own part into thread local columns. Chunk bounds move forward to the next line
+// start, which keeps the parts adjacent.
+std::vector<DataColumns> ParseSortedRuns(std::string_view text, size_t workersCount)
 {
-  return std::inner_product(left.begin(), left.end(), right.begin(), uint32_t(0),
-                            std::plus<>(),
-                            [](uint32_t a, uint32_t b)
-                            {
-                              return std::max(a, b) - std::min(a, b);
-                            });
+  auto lineStart = [text](size_t bound)
+  {
+    while (bound > 0 && bound < text.size() && text[bound - 1] != '\n')
+    {
+      ++bound;
+    }
+    return bound;
+  };
+
+  return ParallelChunks(text.size(), workersCount, [&](size_t begin, size_t end)
+                        {
+                          begin = lineStart(begin);
+                          end = lineStart(end);
+
+                          auto run = ParseColumns(text.substr(begin, end - begin));
+                          RadixSort(run.first);
+                          RadixSort(run.second);
+                          return run; });
 }
 
-uint32_t CalculateSimilarity(const DataColumn &left, const DataColumn &right)
+// Streams the values of several sorted runs in ascending order.
+class SortedRunsMerger
 {
-  return std::accumulate(left.begin(), left.end(), uint32_t(0), [&right](auto acc, const auto &val)
-                         { return acc + val * right.count(val); });
+public:
+  explicit SortedRunsMerger(const std::vector<const DataColumn *> &runs)
+  {
+    for (const auto *run : runs)
+    {
+      if (!run->empty())
+      {
+        heap.push_back({run->data(), run->data() + run->size()});
+      }
+    }
+    std::ranges::make_heap(heap, std::greater<>{});
+  }
+
+  bool Empty() const
+  {
+    return heap.empty();
+  }
+
+  uint32_t Peek() const
+  {
+    return *heap.front().first;
+  }
+
+  uint32_t Pop()
+  {
+    std::ranges::pop_heap(heap, std::greater<>{});
+    auto &[current, end] = heap.back();
+    const uint32_t value = *current++;
+    if (current == end)
+    {
+      heap.pop_back();
+    }
+    else
+    {
+      std::ranges::push_heap(heap, std::greater<>{});
+    }
+    return value;
+  }
+
+private:
+  struct Cursor
+  {
+    const uint32_t *first;
+    const uint32_t *last;
+
+    bool operator>(const Cursor &other) const
+    {
+      return *first > *other.first;
+    }
+  };
+
+  std::vector<Cursor> heap;
+};
+
+// Part 1 and part 2 over the sorted runs of ParseSortedRuns. Both reductions consume
+// k-way merged streams directly, the merged columns are never stored.
+std::pair<uint64_t, uint64_t> SolveSortedRuns(const std::vector<DataColumns> &runs)
+{
+  std::vector<const DataColumn *> leftRuns;
+  std::vector<const DataColumn *> rightRuns;
+  for (const auto &[left, right] : runs)
+  {
+    leftRuns.push_back(&left);
+    rightRuns.push_back(&right);
+  }
+
+  uint64_t distance = 0;
+  {
+    SortedRunsMerger left{leftRuns};
+    SortedRunsMerger right{rightRuns};
+    while (!left.Empty() && !right.Empty())
+    {
+      const uint32_t a = left.Pop();
+      const uint32_t b = right.Pop();
+      distance += std::max(a, b) - std::min(a, b);
+    }
+  }
+
+  uint64_t similarity = 0;
+  {
+    SortedRunsMerger left{leftRuns};
+    SortedRunsMerger right{rightRuns};
+    while (!left.Empty() && !right.Empty())
+    {
+      const uint32_t value = std::min(left.Peek(), right.Peek());
+      uint64_t leftRun = 0;
+      uint64_t rightRun = 0;
+      while (!left.Empty() && left.Peek() == value)
+      {
+        left.Pop();
+        ++leftRun;
+      }
+      while (!right.Empty() && right.Peek() == value)
+      {
+        right.Pop();
+        ++rightRun;
+      }
+      similarity += value * leftRun * rightRun;
+    }
+  }
+
+  return {distance, similarity};
+}
+
+std::pair<uint64_t, uint64_t> SolveParallel(std::string_view text, size_t workersCount = GetWorkersCount())
+{
+  return SolveSortedRuns(ParseSortedRuns(text, workersCount));
 }
 
 TEST_CASE("Read columns")
@@ -59,6 +439,26 @@ TEST_CASE("Read columns")
   REQUIRE(expectedRight == right);
 }
 
+TEST_CASE("Sum distances without overflow")
+{
+  DataColumn left(1000, 0);
+  DataColumn right(1000, 4000000000u);
+  left.push_back(4000000000u);
+  right.push_back(1);
+
+  REQUIRE(1000 * uint64_t(4000000000u) + 3999999999u == SumDistances(left, right));
+}
+
+TEST_CASE("Radix sort")
+{
+  DataColumn values{4000000000u, 7, 2048, 0, 2047, 4194304, 7, 1u << 31, 123456789};
+  DataColumn expected = values;
+  std::ranges::sort(expected);
+
+  RadixSort(values);
+  REQUIRE(expected == values);
+}
+
 TEST_CASE("Check with test data")
 {
   std::stringstream testInput{testData};
@@ -73,6 +473,58 @@ TEST_CASE("Check with test data")
   {
     REQUIRE(31u == CalculateSimilarity(left, right));
   }
+
+  SECTION("Calculate similarity with histogram")
+  {
+    REQUIRE(31u == CalculateSimilarityWithHistogram(left, right, 9));
+    REQUIRE_THROWS_AS(CalculateSimilarityWithHistogram(left, right, 8), std::out_of_range);
+  }
+}
+
+TEST_CASE("Incremental distance and similarity")
+{
+  std::mt19937 generator{2024};
+  std::uniform_int_distribution<uint32_t> distribution{0, 50};
+
+  IncrementalLocationLists lists{50};
+  DataColumn left;
+  DataColumn right;
+
+  for (int i = 0; i < 200; ++i)
+  {
+    const auto lval = distribution(generator);
+    const auto rval = distribution(generator);
+    lists.Insert(lval, rval);
+
+    left.insert(std::ranges::upper_bound(left, lval), lval);
+    right.insert(std::ranges::upper_bound(right, rval), rval);
+
+    REQUIRE(SumDistances(left, right) == lists.GetDistance());
+    REQUIRE(CalculateSimilarity(left, right) == lists.GetSimilarity());
+  }
+}
+
+TEST_CASE("Incremental with test data")
+{
+  std::stringstream testInput{testData};
+  IncrementalLocationLists lists{9};
+  lists.InsertPairs(testInput);
+
+  REQUIRE(11u == lists.GetDistance());
+  REQUIRE(31u == lists.GetSimilarity());
+}
+
+TEST_CASE("Parallel with test data")
+{
+  for (size_t workers = 1; workers <= 8; ++workers)
+  {
+    const auto [distance, similarity] = SolveParallel(testData, workers);
+    REQUIRE(11u == distance);
+    REQUIRE(31u == similarity);
+  }
+
+  REQUIRE(std::pair<uint64_t, uint64_t>{1, 0} == SolveParallel("1 2", 8));
+  REQUIRE(std::pair<uint64_t, uint64_t>{0, 0} == SolveParallel("", 8));
 }
 
 TEST_CASE("Task day 1")
@@ -84,11 +536,37 @@ TEST_CASE("Task day 1")
 
   SECTION("part 1")
   {
-    std::cout << "Day 1 - part 1 result: " << SumDistances(left, right) << std::endl;
+    ReportResult(1, 1, [&]
+                       { return SumDistances(left, right); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 1 - part 2 result: " << CalculateSimilarity(left, right) << std::endl;
+    ReportResult(1, 2, [&]
+                       { return CalculateSimilarity(left, right); });
   }
+
+  SECTION("parallel")
+  {
+    MappedFile file("data.txt");
+    const auto [distance, similarity] = SolveParallel(file.View());
+    REQUIRE(SumDistances(left, right) == distance);
+    REQUIRE(CalculateSimilarity(left, right) == similarity);
+  }
+}
+
+TEST_CASE("Batch day 1")
+{
+  auto part1 = [](std::istream &input)
+  {
+    const auto [left, right] = ReadColumns(input);
+    return SumDistances(left, right);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    const auto [left, right] = ReadColumns(input);
+    return CalculateSimilarity(left, right);
+  };
+
+  RunBatch(1, part1, part2);
 }
\ No newline at end of file
@@ -1,137 +1,432 @@
 #include <catch2/catch_all.hpp>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <iostream>
 #include <fstream>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
-struct IReport
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Levels of a single report parsed into an on-stack buffer. Longer reports move
+// to the heap, so only they pay for an allocation.
+class Levels
 {
 public:
-  virtual bool IsSafe() = 0;
+  static constexpr size_t capacity = 32;
 
-protected:
-  enum class State
+  Levels(std::string_view report)
   {
-    Unknown,
-    Increasing,
-    Decreasing
-  };
+    const char *position = report.data();
+    const char *end = report.data() + report.size();
 
-  static State GetState(int val, int next)
-  {
-    if (next > val)
+    while (position != end)
     {
-      return State::Increasing;
-    }
-    else if (next < val)
-    {
-      return State::Decreasing;
+      if (*position == ' ')
+      {
+        ++position;
+        continue;
+      }
+
+      int value = 0;
+      const auto result = std::from_chars(position, end, value);
+      if (result.ec != std::errc())
+      {
+        break;
+      }
+      if (count < capacity)
+      {
+        values[count] = value;
+      }
+      else
+      {
+        if (count == capacity)
+        {
+          overflow.assign(values.begin(), values.end());
+        }
+        overflow.push_back(value);
+      }
+      ++count;
+      position = result.ptr;
     }
-    return State::Unknown;
   }
+
+  std::span<const int> View() const
+  {
+    return {count > capacity ? overflow.data() : values.data(), count};
+  }
+
+private:
+  std::array<int, capacity> values;
+  std::vector<int> overflow;
+  size_t count = 0;
 };
 
-class Report : public IReport
+enum class Direction
 {
-public:
-  Report(const std::string &report_) : report(report_) {};
-  bool IsSafe() override
+  Increasing,
+  Decreasing,
+  Any
+};
+
+// A step is valid when it moves in the given direction by 1 to maxStep.
+template <Direction direction>
+bool IsValidStep(int val, int next, int maxStep)
+{
+  const int diff = direction == Direction::Increasing ? next - val : val - next;
+  return static_cast<unsigned>(diff - 1) < static_cast<unsigned>(maxStep);
+}
+
+// Allows up to tolerance removed levels. fewest[i] holds the fewest removals that
+// leave a valid sequence ending at kept level i, one for each direction. The level
+// kept before i is at most tolerance + 1 positions back, so the check runs in
+// O(n * k), both directions share a single pass and fewest only needs a ring of
+// tolerance + 2 entries, which WindowSize must cover.
+template <Direction direction, size_t WindowSize>
+bool IsSafeWithTolerance(std::span<const int> values, size_t tolerance, int maxStep)
+{
+  const size_t size = values.size();
+  if (size <= tolerance + 1)
   {
-    std::istringstream stream(report);
-    int val = 0;
-    int last = 0;
-    stream >> last;
+    return true;
+  }
 
-    State lastState = State::Unknown;
+  constexpr bool increasing = direction != Direction::Decreasing;
+  constexpr bool decreasing = direction != Direction::Increasing;
+
+  // Removing every level before i always works, size is out of reach for a
+  // direction that is not checked.
+  std::array<std::array<size_t, 2>, WindowSize> fewest;
+  for (size_t i = 0; i < size; ++i)
+  {
+    auto &[up, down] = fewest[i % WindowSize];
+    up = increasing ? i : size;
+    down = decreasing ? i : size;
 
-    while (stream >> val)
+    for (size_t previous = i - std::min(i, tolerance + 1); previous < i; ++previous)
     {
-      auto state = GetState(last, val);
-      if (std::abs(val - last) > 3 ||
-          state == State::Unknown ||
-          (state != lastState && lastState != State::Unknown))
+      const size_t skipped = i - previous - 1;
+      if (increasing && IsValidStep<Direction::Increasing>(values[previous], values[i], maxStep))
       {
-        return false;
+        up = std::min(up, fewest[previous % WindowSize][0] + skipped);
       }
+      if (decreasing && IsValidStep<Direction::Decreasing>(values[previous], values[i], maxStep))
+      {
+        down = std::min(down, fewest[previous % WindowSize][1] + skipped);
+      }
+    }
 
-      lastState = state;
-      last = val;
+    if (std::min(up, down) + (size - 1 - i) <= tolerance)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Safety rules resolved at compile time, so every configuration gets its own
+// specialised loop. No tolerance is a single pass, a tolerance of one uses prefix
+// and suffix flags to check every removal in O(1), larger ones use the DP above,
+// which covers both directions at once.
+template <size_t Tolerance, int MaxStep = 3, Direction Dir = Direction::Any>
+struct SafetyChecker
+{
+  static bool IsSafe(std::span<const int> values)
+  {
+    if constexpr (Tolerance > 1)
+    {
+      return IsSafeWithTolerance<Dir, Tolerance + 2>(values, Tolerance, MaxStep);
+    }
+    else if constexpr (Dir == Direction::Any)
+    {
+      return SafetyChecker<Tolerance, MaxStep, Direction::Increasing>::IsSafe(values) ||
+             SafetyChecker<Tolerance, MaxStep, Direction::Decreasing>::IsSafe(values);
+    }
+    else if constexpr (Tolerance == 0)
+    {
+      for (size_t i = 1; i < values.size(); ++i)
+      {
+        if (!IsValidStep<Dir>(values[i - 1], values[i], MaxStep))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    else if constexpr (Tolerance == 1)
+    {
+      return IsSafeWithSingleRemoval(values);
     }
-    return true;
   }
 
 private:
-  std::string report;
+  // Levels [0, i] are safe for every i up to prefixEnd and levels [i, n) for every
+  // i from suffixStart, so these two bounds stand in for the prefix and suffix flags
+  // and removing level i is checked by joining both sides.
+  static bool IsSafeWithSingleRemoval(std::span<const int> values)
+  {
+    const size_t size = values.size();
+    if (size <= 2)
+    {
+      return true;
+    }
+
+    size_t prefixEnd = 0;
+    while (prefixEnd + 1 < size && IsValidStep<Dir>(values[prefixEnd], values[prefixEnd + 1], MaxStep))
+    {
+      ++prefixEnd;
+    }
+
+    size_t suffixStart = size - 1;
+    while (suffixStart > 0 && IsValidStep<Dir>(values[suffixStart - 1], values[suffixStart], MaxStep))
+    {
+      --suffixStart;
+    }
+
+    auto prefix = [&](size_t i)
+    {
+      return i <= prefixEnd;
+    };
+    auto suffix = [&](size_t i)
+    {
+      return i >= suffixStart;
+    };
+
+    if (suffix(1) || prefix(size - 2))
+    {
+      return true;
+    }
+
+    for (size_t i = 1; i + 1 < size; ++i)
+    {
+      if (prefix(i - 1) && suffix(i + 1) && IsValidStep<Dir>(values[i - 1], values[i + 1], MaxStep))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
-class ReportWithDampener : public IReport
+template <typename Checker>
+class BasicReport
 {
 public:
-  ReportWithDampener(const std::string &report_)
-  {
-    std::istringstream stream(report_);
-    report_values = std::vector<int>(std::istream_iterator<int>(stream), std::istream_iterator<int>());
-  };
+  BasicReport(std::string_view report) : levels(report) {};
 
-  bool IsSafe() override
+  bool IsSafe() const
   {
-    return IsSafeWithDampener(report_values) || IsSafeWithDampener({report_values.rbegin(), report_values.rend()});
+    return Checker::IsSafe(levels.View());
   }
 
 private:
-  bool IsSafeWithDampener(const std::vector<int> &values)
-  {
-    State lastState = State::Unknown;
-    bool wasSkipped = false;
-    int last = values[0];
+  Levels levels;
+};
 
-    for (size_t i = 1; i < values.size(); ++i)
-    {
-      int val = values[i];
-      auto state = GetState(last, val);
+using Report = BasicReport<SafetyChecker<0>>;
+using ReportWithDampener = BasicReport<SafetyChecker<1>>;
 
-      if (std::abs(val - last) > 3 ||
-          state == State::Unknown ||
-          (state != lastState && lastState != State::Unknown))
-      {
-        if (!wasSkipped)
-        {
-          wasSkipped = true;
-          continue;
-        }
-        return false;
-      }
-      lastState = state;
-      last = val;
+// Tolerance and step bound chosen at run time. The DP window is sized for the
+// largest supported tolerance, so checks stay allocation free.
+class ReportWithTolerance
+{
+public:
+  static constexpr size_t maxTolerance = 30;
+
+  ReportWithTolerance(std::string_view report, size_t tolerance_, int maxStep_ = 3)
+      : levels(report), tolerance(tolerance_), maxStep(maxStep_)
+  {
+    if (tolerance > maxTolerance)
+    {
+      throw std::invalid_argument("Tolerance above " + std::to_string(maxTolerance));
     }
-    return true;
+  };
+
+  bool IsSafe() const
+  {
+    return IsSafeWithTolerance<Direction::Any, maxTolerance + 2>(levels.View(), tolerance, maxStep);
   }
 
-  std::vector<int> report_values;
+private:
+  Levels levels;
+  size_t tolerance;
+  int maxStep;
 };
 
-int CountSafeReports(std::istream &input)
+template <typename ReportType>
+int CountSafe(std::istream &input)
 {
   std::string line;
   int count = 0;
 
   while (std::getline(input, line))
   {
-    count += Report(line).IsSafe();
+    count += ReportType(line).IsSafe();
   }
   return count;
 }
 
+int CountSafeReports(std::istream &input)
+{
+  return CountSafe<Report>(input);
+}
+
 int CountSafeReportsWithDampener(std::istream &input)
+{
+  return CountSafe<ReportWithDampener>(input);
+}
+
+int CountSafeReportsWithTolerance(std::istream &input, size_t tolerance, int maxStep = 3)
 {
   std::string line;
   int count = 0;
 
   while (std::getline(input, line))
   {
-    count += ReportWithDampener(line).IsSafe();
+    count += ReportWithTolerance(line, tolerance, maxStep).IsSafe();
   }
   return count;
 }
 
+// Evaluates part 1 for many short reports at once. Every report is stored as a row
+// of width + 1 levels, padded by repeating its last level, so the adjacent
+// differences of a row fill exactly one vector of width lanes. Padding lanes are
+// masked out of the verdict. Rows are evaluated and cleared every capacity reports,
+// so memory use does not grow with the input.
+class ReportBatch
+{
+public:
+  static constexpr size_t width = 8;
+  static constexpr size_t capacity = 4096;
+
+  ReportBatch()
+  {
+    levels.reserve(capacity * (width + 1));
+    paddingMasks.reserve(capacity);
+  }
+
+  bool IsFull() const
+  {
+    return paddingMasks.size() == capacity;
+  }
+
+  void Clear()
+  {
+    levels.clear();
+    paddingMasks.clear();
+  }
+
+  // Returns false when the report does not fit into a row.
+  bool Add(std::string_view report)
+  {
+    const Levels parsed(report);
+    const auto values = parsed.View();
+    if (values.size() > width + 1)
+    {
+      return false;
+    }
+
+    for (size_t i = 0; i <= width; ++i)
+    {
+      levels.push_back(values.empty() ? 0 : values[std::min(i, values.size() - 1)]);
+    }
+    const size_t usedLanes = values.empty() ? 0 : values.size() - 1;
+    paddingMasks.push_back(static_cast<uint8_t>(0xFFu << usedLanes));
+    return true;
+  }
+
+  size_t CountSafe() const
+  {
+    size_t count = 0;
+    for (size_t row = 0; row < paddingMasks.size(); ++row)
+    {
+      const uint32_t lanes = ValidStepLanes(levels.data() + row * (width + 1));
+      const uint32_t increasing = (lanes & 0xFF) | paddingMasks[row];
+      const uint32_t decreasing = (lanes >> 8) | paddingMasks[row];
+      count += increasing == 0xFF || decreasing == 0xFF;
+    }
+    return count;
+  }
+
+private:
+  // Bits 0-7 mark lanes with an increasing step of 1 to 3, bits 8-15 decreasing ones.
+  static uint32_t ValidStepLanes(const int32_t *row)
+  {
+#if defined(__AVX2__)
+    const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row));
+    const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + 1));
+    const __m256i diff = _mm256_sub_epi32(next, current);
+
+    const __m256i increasing = _mm256_and_si256(_mm256_cmpgt_epi32(diff, _mm256_setzero_si256()),
+                                                _mm256_cmpgt_epi32(_mm256_set1_epi32(4), diff));
+    const __m256i decreasing = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), diff),
+                                                _mm256_cmpgt_epi32(diff, _mm256_set1_epi32(-4)));
+
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(increasing))) |
+           static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(decreasing))) << 8;
+#else
+    uint32_t lanes = 0;
+    for (size_t i = 0; i < width; ++i)
+    {
+      const int32_t diff = row[i + 1] - row[i];
+      lanes |= static_cast<uint32_t>(diff >= 1 && diff <= 3) << i;
+      lanes |= static_cast<uint32_t>(diff >= -3 && diff <= -1) << (i + 8);
+    }
+    return lanes;
+#endif
+  }
+
+  std::vector<int32_t> levels;
+  std::vector<uint8_t> paddingMasks;
+};
+
+int CountSafeReportsBatched(std::istream &input)
+{
+  std::string line;
+  ReportBatch batch;
+  int count = 0;
+
+  while (std::getline(input, line))
+  {
+    if (!batch.Add(line))
+    {
+      count += Report(line).IsSafe();
+    }
+    else if (batch.IsFull())
+    {
+      count += static_cast<int>(batch.CountSafe());
+      batch.Clear();
+    }
+  }
+  return count + static_cast<int>(batch.CountSafe());
+}
+
+// Report of 1 to maxLength levels starting at 50, each step between -4 and 4.
+std::string RandomReport(std::mt19937 &generator, int maxLength)
+{
+  std::uniform_int_distribution<int> lengths{1, maxLength};
+  std::uniform_int_distribution<int> steps{-4, 4};
+
+  std::string report = "50";
+  int value = 50;
+  const int length = lengths(generator);
+  for (int level = 1; level < length; ++level)
+  {
+    value += steps(generator);
+    report += ' ' + std::to_string(value);
+  }
+  return report;
+}
+
 TEST_CASE("Check if safe")
 {
   REQUIRE(Report("7 6 4 2 1").IsSafe());
@@ -152,6 +447,147 @@ TEST_CASE("Check with dampener if safe")
   REQUIRE(ReportWithDampener("1 3 6 7 9").IsSafe());
 }
 
+TEST_CASE("Check dampener against removing every level")
+{
+  std::mt19937 generator{2};
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    const auto report = RandomReport(generator, 8);
+    const Levels levels(report);
+    const auto values = levels.View();
+
+    bool expected = Report(report).IsSafe();
+    for (size_t removed = 0; removed < values.size() && !expected; ++removed)
+    {
+      std::string dampened;
+      for (size_t level = 0; level < values.size(); ++level)
+      {
+        dampened += level == removed ? "" : std::to_string(values[level]) + ' ';
+      }
+      expected = Report(dampened).IsSafe();
+    }
+
+    REQUIRE(expected == ReportWithDampener(report).IsSafe());
+  }
+}
+
+TEST_CASE("Check with tolerance")
+{
+  REQUIRE(ReportWithTolerance("7 6 4 2 1", 0).IsSafe());
+  REQUIRE_FALSE(ReportWithTolerance("1 3 2 4 5", 0).IsSafe());
+  REQUIRE(ReportWithTolerance("1 3 2 4 5", 1).IsSafe());
+  REQUIRE_FALSE(ReportWithTolerance("1 9 2 8 3 4", 1).IsSafe());
+  REQUIRE(ReportWithTolerance("1 9 2 8 3 4", 2).IsSafe());
+  REQUIRE_FALSE(ReportWithTolerance("1 2 7 8 9", 1).IsSafe());
+  REQUIRE(ReportWithTolerance("1 2 7 8 9", 1, 5).IsSafe());
+  REQUIRE(BasicReport<SafetyChecker<2>>("1 9 2 8 3 4").IsSafe());
+  REQUIRE(BasicReport<SafetyChecker<1, 5>>("1 2 7 8 9").IsSafe());
+  REQUIRE_FALSE(BasicReport<SafetyChecker<0, 3, Direction::Decreasing>>("1 2 3").IsSafe());
+  REQUIRE_THROWS_AS(ReportWithTolerance("1 2 3", ReportWithTolerance::maxTolerance + 1), std::invalid_argument);
+
+  std::mt19937 generator{3};
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    const auto report = RandomReport(generator, 8);
+
+    REQUIRE(Report(report).IsSafe() == ReportWithTolerance(report, 0).IsSafe());
+    REQUIRE(ReportWithDampener(report).IsSafe() == ReportWithTolerance(report, 1).IsSafe());
+
+    const Levels levels(report);
+    const auto values = levels.View();
+    bool expected = false;
+    for (uint32_t removed = 0; removed < (1u << values.size()) && !expected; ++removed)
+    {
+      if (std::popcount(removed) > 2)
+      {
+        continue;
+      }
+      std::vector<int> kept;
+      for (size_t level = 0; level < values.size(); ++level)
+      {
+        if ((removed >> level & 1) == 0)
+        {
+          kept.push_back(values[level]);
+        }
+      }
+      expected = SafetyChecker<0>::IsSafe(kept);
+    }
+    REQUIRE(expected == ReportWithTolerance(report, 2).IsSafe());
+    REQUIRE(expected == BasicReport<SafetyChecker<2>>(report).IsSafe());
+  }
+}
+
+TEST_CASE("Check batched reports")
+{
+  std::stringstream testInput{"7 6 4 2 1\n1 2 7 8 9\n9 7 6 2 1\n1 3 2 4 5\n8 6 4 4 1\n1 3 6 7 9\n"
+                              "5\n1 2 3 4 5 6 7 8 9\n1 2 3 4 5 6 7 8 9 10\n1 2 3 4 5 6 7 8 9 9\n"};
+  REQUIRE(5 == CountSafeReportsBatched(testInput));
+
+  std::mt19937 generator{4};
+
+  std::string reports;
+  int expected = 0;
+  for (size_t i = 0; i < 2 * ReportBatch::capacity + 100; ++i)
+  {
+    const auto report = RandomReport(generator, 10);
+    expected += Report(report).IsSafe();
+    reports += report + '\n';
+  }
+
+  std::stringstream randomInput{reports};
+  REQUIRE(expected == CountSafeReportsBatched(randomInput));
+}
+
+TEST_CASE("Check reports longer than the level buffer")
+{
+  std::string increasing;
+  for (int level = 0; level < 40; ++level)
+  {
+    increasing += std::to_string(level * 2) + ' ';
+  }
+  const auto broken = increasing + "1";
+
+  REQUIRE(40 == std::ssize(Levels(increasing).View()));
+  REQUIRE(Report(increasing).IsSafe());
+  REQUIRE_FALSE(Report(broken).IsSafe());
+  REQUIRE(ReportWithDampener(broken).IsSafe());
+  REQUIRE(ReportWithTolerance(broken, 2).IsSafe());
+
+  std::stringstream input{increasing + '\n' + broken + '\n' + "1 2 3\n"};
+  REQUIRE(2 == CountSafeReportsBatched(input));
+
+  std::mt19937 generator{5};
+
+  for (int i = 0; i < 500; ++i)
+  {
+    const auto report = RandomReport(generator, 60);
+
+    REQUIRE(Report(report).IsSafe() == ReportWithTolerance(report, 0).IsSafe());
+    REQUIRE(ReportWithDampener(report).IsSafe() == ReportWithTolerance(report, 1).IsSafe());
+  }
+}
+
+TEST_CASE("Check reports without allocations")
+{
+  std::stringstream testInput{"7 6 4 2 1\n1 3 2 4 5\n8 6 4 4 1\n"};
+  std::string line;
+  line.reserve(64);
+  int count = 0;
+
+  const auto allocationsBefore = GetAllocationStats();
+  while (std::getline(testInput, line))
+  {
+    count += Report(line).IsSafe() + ReportWithDampener(line).IsSafe();
+    count += BasicReport<SafetyChecker<2>>(line).IsSafe() + ReportWithTolerance(line, 3).IsSafe();
+  }
+  const auto allocations = GetAllocationStats() - allocationsBefore;
+
+  REQUIRE(10 == count);
+  REQUIRE(0u == allocations.count);
+}
+
 TEST_CASE("Task day 2")
 {
   std::ifstream data("data.txt");
@@ -160,11 +596,27 @@ TEST_CASE("Task day 2")
 
   SECTION("part 1")
   {
-    std::cout << "Day 2 - part 1 result: " << CountSafeReports(data) << std::endl;
+    ReportResult(2, 1, [&]
+                       { return CountSafeReportsBatched(data); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 2 - part 2 result: " << CountSafeReportsWithDampener(data) << std::endl;
+    ReportResult(2, 2, [&]
+                       { return CountSafeReportsWithDampener(data); });
   }
+}
+
+TEST_CASE("Batch day 2")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return CountSafeReportsBatched(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return CountSafeReportsWithDampener(input);
+  };
+
+  RunBatch(2, part1, part2);
 }
\ No newline at end of file
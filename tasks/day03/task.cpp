@@ -1,68 +1,112 @@
 #include <catch2/catch_all.hpp>
-#include <regex>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/MappedFile.h>
+#include <utils/Parallel.h>
+#include <utils/PatternScanner.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <string_view>
 #include <iostream>
 #include <fstream>
 
 const std::string testData = "xmul(2,4)%&mul[3,7]!@^do_not_mul(5,5)+mul(32,64]then(mul(11,8)mul(8,5))";
 const std::string testDaraWithStates = "xmul(2,4)&mul[3,7]!^don't()_mul(5,5)+mul(32,64](mul(11,8)undo()?mul(8,5))";
 
-int SumMuls(std::istream &input)
+// What a stretch of the input contributes for both states it can be entered with.
+// Summaries of consecutive chunks combine associatively, the empty summary being
+// the identity, so chunks can be scanned independently.
+struct ChunkSummary
 {
-  std::regex mulRegex("mul\\((\\d+),(\\d+)\\)");
-  int sum = 0;
-  std::string line;
-
-  while (std::getline(input, line))
+  enum class Exit : uint8_t
   {
-    std::smatch match;
-    std::string::const_iterator search_start(line.cbegin());
+    Unchanged,
+    Enabled,
+    Disabled
+  };
 
-    while (std::regex_search(search_start, line.cend(), match, mulRegex))
-    {
-      int x = std::stoi(match[1].str());
-      int y = std::stoi(match[2].str());
-      sum += x * y;
+  int64_t sumIfEnabled = 0;
+  int64_t sumIfDisabled = 0;
+  Exit exit = Exit::Unchanged;
+};
 
-      search_start = match.suffix().first;
-    }
-  }
+ChunkSummary Combine(const ChunkSummary &left, const ChunkSummary &right)
+{
+  using enum ChunkSummary::Exit;
 
-  return sum;
+  const auto &afterEnabled = left.exit == Disabled ? right.sumIfDisabled : right.sumIfEnabled;
+  const auto &afterDisabled = left.exit == Enabled ? right.sumIfEnabled : right.sumIfDisabled;
+  return {left.sumIfEnabled + afterEnabled,
+          left.sumIfDisabled + afterDisabled,
+          right.exit == Unchanged ? left.exit : right.exit};
 }
 
-int SumMulsWithStates(std::istream &input)
-{
-  bool enabled = true;
-  std::regex keyRegex("(don't)|(do)|mul\\((\\d+),(\\d+)\\)");
-  int sum = 0;
-  std::string line;
+using InstructionGrammar = Grammar<"mul(#,#)", "do()", "don't()">;
 
-  while (std::getline(input, line))
-  {
-    std::smatch match;
-    std::string::const_iterator search_start(line.cbegin());
+// The summary has to outlive the returned scanner.
+auto MakeInstructionScanner(ChunkSummary &summary, bool withConditionals)
+{
+  using enum ChunkSummary::Exit;
 
-    while (std::regex_search(search_start, line.cend(), match, keyRegex))
-    {
-      if (match.str() == "do")
-      {
-        enabled = true;
-      }
-      else if (match.str() == "don't")
+  return MakePatternScanner<InstructionGrammar>(
+      [&summary](int64_t first, int64_t second)
       {
-        enabled = false;
-      }
-      else if (enabled)
-      {
-        int x = std::stoi(match[3].str());
-        int y = std::stoi(match[4].str());
-        sum += x * y;
-      }
-      search_start = match.suffix().first;
-    }
+        summary.sumIfEnabled += summary.exit != Disabled ? first * second : 0;
+        summary.sumIfDisabled += summary.exit == Enabled ? first * second : 0;
+      },
+      [&summary, withConditionals]
+      { summary.exit = withConditionals ? Enabled : summary.exit; },
+      [&summary, withConditionals]
+      { summary.exit = withConditionals ? Disabled : summary.exit; });
+}
+
+// Reads the input in fixed-size blocks at constant memory, the scanner state carries
+// tokens over block and line boundaries.
+template <size_t BufferSize = 1 << 16>
+int64_t ScanStream(std::istream &input, bool withConditionals)
+{
+  ChunkSummary summary;
+  auto scanner = MakeInstructionScanner(summary, withConditionals);
+  std::array<char, BufferSize> buffer;
+
+  while (input.read(buffer.data(), buffer.size()) || input.gcount() > 0)
+  {
+    scanner.Scan({buffer.data(), static_cast<size_t>(input.gcount())});
   }
 
-  return sum;
+  return summary.sumIfEnabled;
+}
+
+int64_t SumMuls(std::istream &input)
+{
+  return ScanStream(input, false);
+}
+
+int64_t SumMulsWithStates(std::istream &input)
+{
+  return ScanStream(input, true);
+}
+
+// Every worker owns the tokens starting inside its chunk, finishing the last one past
+// the chunk end. The grammar guarantees that a scan started at any offset recognises
+// exactly the tokens after it.
+ChunkSummary ScanChunk(std::string_view text, size_t begin, size_t end, bool withConditionals)
+{
+  ChunkSummary summary;
+  auto scanner = MakeInstructionScanner(summary, withConditionals);
+  scanner.Scan(text.substr(begin, end - begin));
+  scanner.FinishToken(text.substr(end));
+  return summary;
+}
+
+int64_t SumMulsParallel(std::string_view text, bool withConditionals, size_t workersCount = GetWorkersCount())
+{
+  const auto summaries = ParallelChunks(text.size(), workersCount, [&](size_t begin, size_t end)
+                                        { return ScanChunk(text, begin, end, withConditionals); });
+
+  return std::accumulate(summaries.begin(), summaries.end(), ChunkSummary{}, Combine).sumIfEnabled;
 }
 
 TEST_CASE("Check sum muls for test data")
@@ -77,6 +121,100 @@ TEST_CASE("Check sum muls for test data with states")
   REQUIRE(SumMulsWithStates(input) == 48);
 }
 
+TEST_CASE("Check scanner edge cases")
+{
+  std::stringstream input{"mumul(1,2)mul(3,4mul(5,6))mul(12345,2)mul( 1,2)mul(1,2 )don't(mul(2,2)do(mul(3,3)don't()mul(7,7)do()mul(1,1)"};
+  REQUIRE(2 + 30 + 4 + 9 + 1 == SumMulsWithStates(input));
+}
+
+TEST_CASE("Check operands of up to three digits")
+{
+  std::stringstream input{"mul(999,999)mul(1234,5)mul(5,1234)mul(007,2)mul(" + std::string(30, '9') + ",2)mul(0,1)"};
+  REQUIRE(998001 + 14 == SumMuls(input));
+
+  const std::string text = "mul(12,3)mul(123456789012345678901234567890,2)";
+  REQUIRE(36 == SumMulsParallel(text, false, 4));
+}
+
+TEST_CASE("Check tokens across buffers and lines")
+{
+  const std::string text = testDaraWithStates + "\nmul(1\n2,\r\n3)do()mul(4,\n5)mul\n(6,6)xm\nul(1,1)";
+  const int64_t expected = 48 + 36 + 20 + 36 + 1;
+
+  std::stringstream input{text};
+  REQUIRE(expected == SumMulsWithStates(input));
+
+  std::stringstream tinyBuffers{text};
+  REQUIRE(expected == ScanStream<1>(tinyBuffers, true));
+
+  std::stringstream oddBuffers{text};
+  REQUIRE(expected == ScanStream<7>(oddBuffers, true));
+
+  REQUIRE(expected == SumMulsParallel(text, true, 5));
+
+  const std::string wrapped = "mul(1\n2,3)";
+
+  std::stringstream wrappedInput{wrapped};
+  REQUIRE(36 == SumMuls(wrappedInput));
+
+  std::stringstream wrappedBuffers{wrapped};
+  REQUIRE(36 == ScanStream<2>(wrappedBuffers, false));
+
+  for (size_t workers = 1; workers <= wrapped.size(); ++workers)
+  {
+    REQUIRE(36 == SumMulsParallel(wrapped, false, workers));
+  }
+}
+
+TEST_CASE("Check token start prefilter")
+{
+  const std::string text = std::string(70, 'x') + "m" + std::string(40, '.') + "d";
+
+  const auto &starts = InstructionGrammar::startBytes;
+
+  REQUIRE(70 == FindTokenStart(text, 0, starts));
+  REQUIRE(70 == FindTokenStart(text, 70, starts));
+  REQUIRE(111 == FindTokenStart(text, 71, starts));
+  REQUIRE(text.size() == FindTokenStart(text, 112, starts));
+  REQUIRE(3 == FindTokenStart("\x80\x01\x01d", 0, starts));
+}
+
+TEST_CASE("Check compiled grammar with other instructions")
+{
+  using CalculatorGrammar = Grammar<"add(#,#)", "neg(#)", "nop()">;
+  static_assert(CalculatorGrammar::maxOperands == 2);
+  static_assert(CalculatorGrammar::startBytes == std::array{'a', 'n'});
+
+  int64_t total = 0;
+  int nops = 0;
+  auto scanner = MakePatternScanner<CalculatorGrammar>(
+      [&](int64_t a, int64_t b)
+      { total += a + b; },
+      [&](int64_t a)
+      { total -= a; },
+      [&]
+      { ++nops; });
+
+  scanner.Scan("xadd(2,3)neg(10)nnop()aadd(1,");
+  REQUIRE(scanner.IsInsideToken());
+  scanner.Scan("1)neg()nop(1)ad");
+  REQUIRE(-3 == total);
+  REQUIRE(1 == nops);
+}
+
+TEST_CASE("Check parallel scan")
+{
+  const std::string text = testDaraWithStates + "mumul(1,2)do()mul(3,4mul(5,6))mul(12345,2)mul(123,2)don't(mul(2,2)";
+  std::stringstream input{text};
+  const auto expected = SumMulsWithStates(input);
+
+  for (size_t workers = 1; workers <= text.size() + 1; ++workers)
+  {
+    REQUIRE(expected == SumMulsParallel(text, true, workers));
+  }
+  REQUIRE(161 == SumMulsParallel(testData, false, 7));
+}
+
 TEST_CASE("Task day 3")
 {
   std::ifstream data("data.txt");
@@ -85,11 +223,33 @@ TEST_CASE("Task day 3")
 
   SECTION("part 1")
   {
-    std::cout << "Day 3 - part 1 result: " << SumMuls(data) << std::endl;
+    ReportResult(3, 1, [&]
+                       { return SumMuls(data); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 3 - part 2 result: " << SumMulsWithStates(data) << std::endl;
+    ReportResult(3, 2, [&]
+                       { return SumMulsWithStates(data); });
   }
+
+  SECTION("parallel")
+  {
+    MappedFile file("data.txt");
+    REQUIRE(SumMulsWithStates(data) == SumMulsParallel(file.View(), true));
+  }
+}
+
+TEST_CASE("Batch day 3")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return SumMuls(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return SumMulsWithStates(input);
+  };
+
+  RunBatch(3, part1, part2);
 }
\ No newline at end of file
@@ -1,7 +1,26 @@
 #include <catch2/catch_all.hpp>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Parallel.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <iostream>
 #include <fstream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 constexpr auto testData = R"(MMMSXXMASM
 MSAMXMSMSA
 AMXSXMAAMM
@@ -13,88 +32,486 @@ SAXAMASAAA
 MAMMMXMMMM
 MXMXAXMASX)";
 
-std::vector<std::string> ReadLines(std::istream &input)
+// Letters stored row after row in one buffer and surrounded by sentinel cells, so
+// kernels looking up to padding cells away need no edge checks. Slack at the end
+// covers a block load starting at any cell.
+struct LetterGrid
 {
-  std::vector<std::string> lines;
+  static constexpr size_t padding = 3;
+  static constexpr char sentinel = '\0';
+
+  std::string cells;
+  size_t rows = 0;
+  size_t columns = 0;
+
+  size_t Stride() const
+  {
+    return columns + 2 * padding;
+  }
+
+  const char *At(ptrdiff_t row, ptrdiff_t column) const
+  {
+    constexpr auto offset = static_cast<ptrdiff_t>(padding);
+    return cells.data() + (row + offset) * static_cast<ptrdiff_t>(Stride()) + column + offset;
+  }
+};
+
+#if defined(__AVX2__)
+constexpr size_t blockSize = 32;
+
+// Bit i is set when cells[i] == letter.
+uint32_t MatchBlock(const char *cells, char letter)
+{
+  const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cells));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(letter))));
+}
+#else
+constexpr size_t blockSize = 8;
+
+// Bit i is set when cells[i] == letter.
+uint32_t MatchBlock(const char *cells, char letter)
+{
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    constexpr uint64_t ones = 0x0101010101010101ull;
+    constexpr uint64_t lowBits = 0x7f7f7f7f7f7f7f7full;
+
+    uint64_t word;
+    std::memcpy(&word, cells, sizeof(word));
+    word ^= static_cast<unsigned char>(letter) * ones;
+
+    // High bit of every zero byte, then gathered into the top byte.
+    const uint64_t zeroBytes = ~(((word & lowBits) + lowBits) | word | lowBits);
+    return static_cast<uint32_t>(((zeroBytes >> 7) * 0x0102040810204080ull) >> 56);
+  }
+  else
+  {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < blockSize; ++i)
+    {
+      mask |= static_cast<uint32_t>(cells[i] == letter) << i;
+    }
+    return mask;
+  }
+}
+#endif
+
+// Rows shorter than the first one are padded with sentinels, longer ones truncated.
+LetterGrid ReadGrid(std::istream &input)
+{
+  constexpr size_t padding = LetterGrid::padding;
+  constexpr char sentinel = LetterGrid::sentinel;
+
+  LetterGrid grid;
   std::string line;
 
   while (std::getline(input, line))
   {
-    lines.push_back(line);
+    if (grid.rows++ == 0)
+    {
+      grid.columns = line.size();
+      grid.cells.assign(padding * grid.Stride(), sentinel);
+    }
+
+    line.resize(grid.columns, sentinel);
+    grid.cells.append(padding, sentinel);
+    grid.cells += line;
+    grid.cells.append(padding, sentinel);
   }
-  return lines;
+
+  grid.cells.append(padding * grid.Stride() + blockSize, sentinel);
+  return grid;
 }
 
-int CountXmas(const std::vector<std::string> &lines)
+// Rows [first, last) holding the anchors of the matches to count, the first row of a
+// word or the centre of an X-MAS. Kernels read up to 3 rows past the band.
+struct RowBand
 {
-  int xmasCount = 0;
-  auto checkWords = [](const std::vector<std::string> &words)
+  size_t first = 0;
+  size_t last = ~size_t{0};
+};
+
+constexpr uint32_t LanesMask(size_t lanes)
+{
+  return lanes >= 32 ? ~0u : (1u << lanes) - 1;
+}
+
+// Occurrences of a word running from its first letter in direction (rowStep, columnStep),
+// columnStep being -1, 0 or 1 and rowStep 0 or 1. Every block of cells is compared
+// with the first letter, the block shifted by one step with the second and so on.
+size_t CountWord(const LetterGrid &grid, std::string_view word, size_t rowStep, int columnStep, RowBand band = {})
+{
+  if (word.size() > LetterGrid::padding + 1)
   {
-    return std::count_if(words.begin(), words.end(), [](const std::string &word)
-                         { return word == "XMAS" || std::string(word.rbegin(), word.rend()) == "XMAS"; });
+    throw std::invalid_argument("Word longer than the grid padding");
+  }
+
+  size_t count = 0;
+  for (size_t row = band.first; row < std::min(band.last, grid.rows); ++row)
+  {
+    for (size_t column = 0; column < grid.columns; column += blockSize)
+    {
+      uint32_t mask = word.empty() ? 0 : LanesMask(grid.columns - column);
+      for (size_t i = 0; i < word.size() && mask != 0; ++i)
+      {
+        const auto step = static_cast<ptrdiff_t>(i);
+        mask &= MatchBlock(grid.At(static_cast<ptrdiff_t>(row) + step * static_cast<ptrdiff_t>(rowStep),
+                                   static_cast<ptrdiff_t>(column) + step * columnStep),
+                           word[i]);
+      }
+      count += std::popcount(mask);
+    }
+  }
+
+  return count;
+}
+
+size_t CountXmas(const LetterGrid &grid, RowBand band = {})
+{
+  size_t count = 0;
+  for (const std::string_view word : {"XMAS", "SAMX"})
+  {
+    count += CountWord(grid, word, 0, 1, band) + CountWord(grid, word, 1, 0, band) +
+             CountWord(grid, word, 1, 1, band) + CountWord(grid, word, 1, -1, band);
+  }
+  return count;
+}
+
+// Every 'A' whose both diagonals read MAS in either direction.
+size_t CountCrossedMas(const LetterGrid &grid, RowBand band = {})
+{
+  auto diagonal = [](const char *first, const char *second)
+  {
+    return (MatchBlock(first, 'M') & MatchBlock(second, 'S')) |
+           (MatchBlock(first, 'S') & MatchBlock(second, 'M'));
   };
 
-  for (size_t row = 0; row < lines.size(); ++row)
+  size_t count = 0;
+  for (size_t row = band.first; row < std::min(band.last, grid.rows); ++row)
   {
-    for (size_t column = 0; column < lines[row].size(); ++column)
+    const char *above = grid.At(static_cast<ptrdiff_t>(row) - 1, 0);
+    const char *centre = grid.At(static_cast<ptrdiff_t>(row), 0);
+    const char *below = grid.At(static_cast<ptrdiff_t>(row) + 1, 0);
+
+    for (size_t column = 0; column < grid.columns; column += blockSize)
     {
-      std::vector<std::string> words;
+      uint32_t mask = LanesMask(grid.columns - column) & MatchBlock(centre + column, 'A');
+      if (mask != 0)
+      {
+        mask &= diagonal(above + column - 1, below + column + 1) &
+                diagonal(above + column + 1, below + column - 1);
+      }
+      count += std::popcount(mask);
+    }
+  }
+
+  return count;
+}
 
-      // horizontal
-      if (column < lines[row].size() - 3)
-        words.push_back(lines[row].substr(column, 4));
+// Splits the rows into one band per worker. Every match is counted by the band of its
+// anchor row only, reading the 3 rows of halo below the band from the shared grid.
+template <typename Kernel>
+size_t CountInBands(const LetterGrid &grid, Kernel kernel, size_t workersCount)
+{
+  const auto counts = ParallelChunks(grid.rows, workersCount, [&](size_t first, size_t last)
+                                     { return kernel(grid, RowBand{first, last}); });
 
-      // vertical
-      if (row < lines.size() - 3)
-        words.push_back({lines[row][column], lines[row + 1][column], lines[row + 2][column], lines[row + 3][column]});
+  return std::accumulate(counts.begin(), counts.end(), size_t{0});
+}
 
-      // diagonally down-right
-      if (row < lines.size() - 3 && column < lines[row].size() - 3)
-        words.push_back({lines[row][column], lines[row + 1][column + 1], lines[row + 2][column + 2], lines[row + 3][column + 3]});
+size_t CountXmasParallel(const LetterGrid &grid, size_t workersCount = GetWorkersCount())
+{
+  return CountInBands(grid, [](const LetterGrid &letters, RowBand band)
+                      { return CountXmas(letters, band); }, workersCount);
+}
 
-      // diagonally down-left
-      if (row < lines.size() - 3 && column >= 3)
-        words.push_back({lines[row][column], lines[row + 1][column - 1], lines[row + 2][column - 2], lines[row + 3][column - 3]});
+size_t CountCrossedMasParallel(const LetterGrid &grid, size_t workersCount = GetWorkersCount())
+{
+  return CountInBands(grid, [](const LetterGrid &letters, RowBand band)
+                      { return CountCrossedMas(letters, band); }, workersCount);
+}
 
-      xmasCount += checkWords(words);
+// Finds a dictionary of words in one pass over bit planes of the grid, one plane per
+// letter the words use, 64 cells per machine word. Every start cell and direction
+// counts, so a palindrome is found once each way, except single letters found once.
+class WordSearcher
+{
+public:
+  WordSearcher(const LetterGrid &grid, std::vector<std::string> words_)
+      : words(std::move(words_)), rows(grid.rows), rowWords((grid.columns + 63) / 64)
+  {
+    planeOfLetter.fill(noPlane);
+    for (const auto &word : words)
+    {
+      for (const char letter : word)
+      {
+        auto &plane = planeOfLetter[static_cast<unsigned char>(letter)];
+        plane = plane == noPlane ? planesCount++ : plane;
+      }
+    }
+
+    planes.assign(planesCount * rows * rowWords, 0);
+    for (size_t row = 0; row < rows; ++row)
+    {
+      for (size_t column = 0; column < grid.columns; ++column)
+      {
+        const char letter = *grid.At(static_cast<ptrdiff_t>(row), static_cast<ptrdiff_t>(column));
+        if (const auto plane = planeOfLetter[static_cast<unsigned char>(letter)]; plane != noPlane)
+        {
+          planes[(plane * rows + row) * rowWords + column / 64] |= uint64_t{1} << (column % 64);
+        }
+      }
     }
   }
 
-  return xmasCount;
+  // Occurrences of every word, in the order of the dictionary.
+  std::vector<size_t> Count() const
+  {
+    constexpr std::array<std::pair<size_t, int>, 4> directions{{{0, 1}, {1, 0}, {1, 1}, {1, -1}}};
+
+    std::vector<std::string> reversed;
+    for (const auto &word : words)
+    {
+      reversed.emplace_back(word.rbegin(), word.rend());
+    }
+
+    std::vector<size_t> counts(words.size(), 0);
+    for (size_t row = 0; row < rows; ++row)
+    {
+      for (size_t i = 0; i < words.size(); ++i)
+      {
+        if (words[i].size() == 1)
+        {
+          counts[i] += CountAt(words[i], row, 0, 0);
+          continue;
+        }
+
+        for (const auto &[rowStep, columnStep] : directions)
+        {
+          counts[i] += CountAt(words[i], row, rowStep, columnStep) + CountAt(reversed[i], row, rowStep, columnStep);
+        }
+      }
+    }
+    return counts;
+  }
+
+private:
+  static constexpr size_t noPlane = ~size_t{0};
+
+  // Occurrences starting in the given row, each bit of the mask marks a start cell.
+  size_t CountAt(const std::string &word, size_t row, size_t rowStep, int columnStep) const
+  {
+    if (word.empty() || row + (word.size() - 1) * rowStep >= rows)
+    {
+      return 0;
+    }
+
+    size_t count = 0;
+    for (size_t index = 0; index < rowWords; ++index)
+    {
+      uint64_t mask = ~uint64_t{0};
+      for (size_t i = 0; i < word.size() && mask != 0; ++i)
+      {
+        const auto plane = planeOfLetter[static_cast<unsigned char>(word[i])];
+        const auto first = static_cast<long long>(index * 64) + static_cast<long long>(i) * columnStep;
+        mask &= Bits(plane, row + i * rowStep, first);
+      }
+      count += std::popcount(mask);
+    }
+    return count;
+  }
+
+  // Cells [first, first + 64) of a plane row, zero outside the grid.
+  uint64_t Bits(size_t plane, size_t row, long long first) const
+  {
+    const uint64_t *cells = planes.data() + (plane * rows + row) * rowWords;
+    auto word = [&](long long index)
+    {
+      return index < 0 || index >= static_cast<long long>(rowWords) ? uint64_t{0} : cells[index];
+    };
+
+    const long long index = first >= 0 ? first / 64 : -((-first + 63) / 64);
+    const auto shift = static_cast<unsigned>(first - index * 64);
+    return shift == 0 ? word(index) : (word(index) >> shift) | (word(index + 1) << (64 - shift));
+  }
+
+  std::vector<std::string> words;
+  size_t rows;
+  size_t rowWords;
+  size_t planesCount = 0;
+  std::array<size_t, 256> planeOfLetter;
+  std::vector<uint64_t> planes;
+};
+
+// XMAS and X-MAS counts looked up cell by cell in the lines, a reference for the
+// grid kernels.
+std::pair<size_t, size_t> CountOnLines(const std::vector<std::string> &lines)
+{
+  auto at = [&](ptrdiff_t row, ptrdiff_t column)
+  {
+    const bool inside = row >= 0 && row < std::ssize(lines) && column >= 0 && column < std::ssize(lines[row]);
+    return inside ? lines[row][column] : '.';
+  };
+  auto isMas = [](char first, char last)
+  {
+    return (first == 'M' && last == 'S') || (first == 'S' && last == 'M');
+  };
+
+  size_t xmas = 0;
+  size_t crossedMas = 0;
+  for (ptrdiff_t row = 0; row < std::ssize(lines); ++row)
+  {
+    for (ptrdiff_t column = 0; column < std::ssize(lines[row]); ++column)
+    {
+      for (ptrdiff_t rowStep = -1; rowStep <= 1; ++rowStep)
+      {
+        for (ptrdiff_t columnStep = -1; columnStep <= 1; ++columnStep)
+        {
+          bool found = rowStep != 0 || columnStep != 0;
+          for (ptrdiff_t i = 0; i < 4 && found; ++i)
+          {
+            found = at(row + i * rowStep, column + i * columnStep) == "XMAS"[i];
+          }
+          xmas += found;
+        }
+      }
+
+      crossedMas += at(row, column) == 'A' &&
+                    isMas(at(row - 1, column - 1), at(row + 1, column + 1)) &&
+                    isMas(at(row - 1, column + 1), at(row + 1, column - 1));
+    }
+  }
+  return {xmas, crossedMas};
+}
+
+TEST_CASE("Check grid kernels with test data")
+{
+  std::stringstream testInput{testData};
+  const auto grid = ReadGrid(testInput);
+
+  REQUIRE(10u == grid.rows);
+  REQUIRE(10u == grid.columns);
+  REQUIRE(18u == CountXmas(grid));
+  REQUIRE(9u == CountCrossedMas(grid));
+
+  std::vector<std::string> lines;
+  std::stringstream linesInput{testData};
+  for (std::string line; std::getline(linesInput, line);)
+  {
+    lines.push_back(line);
+  }
+  REQUIRE(std::pair<size_t, size_t>{18, 9} == CountOnLines(lines));
+
+  std::stringstream rowInput{"SAMXMAS"};
+  REQUIRE(2u == CountXmas(ReadGrid(rowInput)));
+
+  std::stringstream columnInput{"X\nM\nA\nS"};
+  REQUIRE(1u == CountXmas(ReadGrid(columnInput)));
 }
 
-int CountCrossedMas(const std::vector<std::string> &lines)
+// Random rows and columns count up to maxSize, filled with XMAS letters.
+std::string RandomGrid(std::mt19937 &generator, size_t maxSize)
 {
-  int xmasCount = 0;
+  std::uniform_int_distribution<size_t> sizes{1, maxSize};
+  std::uniform_int_distribution<size_t> letters{0, 3};
 
-  for (size_t row = 1; row < lines.size() - 1; ++row)
+  const size_t rows = sizes(generator);
+  const size_t columns = sizes(generator);
+  std::string text;
+  for (size_t row = 0; row < rows; ++row)
   {
-    for (size_t column = 1; column < lines.at(row).size() - 1; ++column)
+    for (size_t column = 0; column < columns; ++column)
     {
-      std::vector<std::string> words;
-      std::string xmas = "MAS";
+      text += "XMAS"[letters(generator)];
+    }
+    text += '\n';
+  }
+  return text;
+}
 
-      words.push_back(std::string{lines.at(row - 1)[column - 1], lines.at(row)[column], lines.at(row + 1)[column + 1]});
-      words.push_back(std::string{lines.at(row - 1)[column + 1], lines.at(row)[column], lines.at(row + 1)[column - 1]});
+TEST_CASE("Check grid kernels against line scans")
+{
+  std::mt19937 generator{4};
 
-      xmasCount += (words[0] == xmas || std::string(words[0].rbegin(), words[0].rend()) == xmas) &&
-                   (words[1] == xmas || std::string(words[1].rbegin(), words[1].rend()) == xmas);
+  for (int i = 0; i < 50; ++i)
+  {
+    const auto text = RandomGrid(generator, 80);
+
+    std::stringstream linesInput{text};
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(linesInput, line);)
+    {
+      lines.push_back(line);
     }
+
+    std::stringstream gridInput{text};
+    const auto grid = ReadGrid(gridInput);
+
+    REQUIRE(CountOnLines(lines) == std::pair{CountXmas(grid), CountCrossedMas(grid)});
   }
+}
+
+TEST_CASE("Check padded grid")
+{
+  std::stringstream testInput{"XMAS\nSAMX\nMM"};
+  const auto grid = ReadGrid(testInput);
 
-  return xmasCount;
+  REQUIRE(3u == grid.rows);
+  REQUIRE(4u == grid.columns);
+  REQUIRE(std::string_view(grid.At(0, 0), 4) == "XMAS");
+  REQUIRE(std::string_view(grid.At(2, -3), 10) == std::string_view("\0\0\0MM\0\0\0\0\0", 10));
+  REQUIRE(LetterGrid::sentinel == *grid.At(-3, -3));
+  REQUIRE(LetterGrid::sentinel == *grid.At(5, 6));
+  REQUIRE(grid.cells.size() == 9 * grid.Stride() + blockSize);
+  REQUIRE_THROWS_AS(CountWord(grid, "XMASX", 0, 1), std::invalid_argument);
 }
 
-TEST_CASE("Check part 1 with test data")
+TEST_CASE("Check row bands")
 {
   std::stringstream testInput{testData};
-  REQUIRE(CountXmas(ReadLines(testInput)) == 18);
+  const auto grid = ReadGrid(testInput);
+
+  for (size_t workers = 1; workers <= grid.rows + 2; ++workers)
+  {
+    REQUIRE(18u == CountXmasParallel(grid, workers));
+    REQUIRE(9u == CountCrossedMasParallel(grid, workers));
+  }
 }
 
-TEST_CASE("Check part 2 with test data")
+TEST_CASE("Check word searcher")
 {
   std::stringstream testInput{testData};
-  REQUIRE(CountCrossedMas(ReadLines(testInput)) == 9);
+  const auto grid = ReadGrid(testInput);
+
+  const auto counts = WordSearcher(grid, {"XMAS", "A", "QX"}).Count();
+  REQUIRE(18u == counts[0]);
+  REQUIRE(static_cast<size_t>(std::ranges::count(grid.cells, 'A')) == counts[1]);
+  REQUIRE(0u == counts[2]);
+
+  std::stringstream rowInput{"XMASAMXMASAMX"};
+  REQUIRE(std::vector<size_t>{4} == WordSearcher(ReadGrid(rowInput), {"XMASAMX"}).Count());
+
+  std::mt19937 generator{7};
+  const std::vector<std::string> words{"XMAS", "MAS", "SAS", "SAMX", "AX"};
+
+  for (int i = 0; i < 20; ++i)
+  {
+    std::stringstream randomInput{RandomGrid(generator, 150)};
+    const auto randomGrid = ReadGrid(randomInput);
+
+    const auto randomCounts = WordSearcher(randomGrid, words).Count();
+    for (size_t word = 0; word < words.size(); ++word)
+    {
+      const std::string reversed(words[word].rbegin(), words[word].rend());
+      size_t expected = 0;
+      for (const auto &text : {words[word], reversed})
+      {
+        expected += CountWord(randomGrid, text, 0, 1) + CountWord(randomGrid, text, 1, 0) +
+                    CountWord(randomGrid, text, 1, 1) + CountWord(randomGrid, text, 1, -1);
+      }
+      REQUIRE(expected == randomCounts[word]);
+    }
+  }
 }
 
 TEST_CASE("Task day 4")
@@ -105,11 +522,34 @@ TEST_CASE("Task day 4")
 
   SECTION("part 1")
   {
-    std::cout << "Day 4 - part 1 result: " << CountXmas(ReadLines(data)) << std::endl;
+    ReportResult(4, 1, [&]
+                       { return CountXmas(ReadGrid(data)); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 4 - part 2 result: " << CountCrossedMas(ReadLines(data)) << std::endl;
+    ReportResult(4, 2, [&]
+                       { return CountCrossedMas(ReadGrid(data)); });
   }
+
+  SECTION("parallel")
+  {
+    const auto grid = ReadGrid(data);
+    REQUIRE(CountXmas(grid) == CountXmasParallel(grid));
+    REQUIRE(CountCrossedMas(grid) == CountCrossedMasParallel(grid));
+  }
+}
+
+TEST_CASE("Batch day 4")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return CountXmas(ReadGrid(input));
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return CountCrossedMas(ReadGrid(input));
+  };
+
+  RunBatch(4, part1, part2);
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include <catch2/catch_all.hpp>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <iostream>
 #include <fstream>
 #include <regex>
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <stdexcept>
 
 constexpr auto testData = R"(47|53
 97|13
@@ -88,13 +93,66 @@ bool IsUpdateValid(const std::vector<int> &update, const Rules &rules)
   return true;
 }
 
+// Precedence rules as a bit matrix, row a holding every page b of a rule a|b. An update
+// is checked with one row AND per page, whatever the number of rules.
+template <size_t Pages = 100>
+class PrecedenceMatrix
+{
+public:
+  explicit PrecedenceMatrix(const Rules &rules)
+  {
+    for (const auto &rule : rules)
+    {
+      if (rule.size() != 2 || !IsPage(rule[0]) || !IsPage(rule[1]))
+      {
+        throw std::out_of_range("Rule outside of the precedence matrix");
+      }
+      successors[rule[0]].set(rule[1]);
+    }
+  }
+
+  bool MustPrecede(int first, int second) const
+  {
+    return IsPage(first) && IsPage(second) && successors[first].test(second);
+  }
+
+  // Valid when no page has to precede one of the pages before it.
+  bool IsUpdateValid(const std::vector<int> &update) const
+  {
+    std::bitset<Pages> earlier;
+
+    for (const int page : update)
+    {
+      if (!IsPage(page))
+      {
+        continue;
+      }
+      if ((successors[page] & earlier).any())
+      {
+        return false;
+      }
+      earlier.set(page);
+    }
+    return true;
+  }
+
+private:
+  static constexpr bool IsPage(int page)
+  {
+    return page >= 0 && static_cast<size_t>(page) < Pages;
+  }
+
+  std::array<std::bitset<Pages>, Pages> successors{};
+};
+
 int SumMidElementOfValidUpdates(const Rules &rules, const Updates &updates)
 {
+  const PrecedenceMatrix precedence{rules};
   int count = 0;
 
   for (const auto &update : updates)
   {
-    if (IsUpdateValid(update, rules))
+    if (precedence.IsUpdateValid(update))
     {
       count += update[update.size() / 2];
     }
@@ -128,11 +186,12 @@ std::vector<int> FixUpdateWithRules(std::vector<int> update, const Rules &rules)
 
 int SumMidElementOfNotValidUpdates(const Rules &rules, const Updates &updates)
 {
+  const PrecedenceMatrix precedence{rules};
   int count = 0;
 
   for (const auto &update : updates)
   {
-    if (!IsUpdateValid(update, rules))
+    if (!precedence.IsUpdateValid(update))
     {
       count += FixUpdateWithRules(update, rules)[update.size() / 2];
     }
@@ -157,6 +216,27 @@ TEST_CASE("Check with test data")
   }
 }
 
+TEST_CASE("Check precedence matrix")
+{
+  std::stringstream testInput{testData};
+  const auto &[rules, updates] = ReadRulesAndUpdates(testInput);
+  const PrecedenceMatrix precedence{rules};
+
+  REQUIRE(precedence.MustPrecede(47, 53));
+  REQUIRE_FALSE(precedence.MustPrecede(53, 47));
+  REQUIRE_FALSE(precedence.MustPrecede(47, 100));
+
+  for (const auto &update : updates)
+  {
+    REQUIRE(IsUpdateValid(update, rules) == precedence.IsUpdateValid(update));
+  }
+  REQUIRE(precedence.IsUpdateValid({75, 120, 47}));
+  REQUIRE_FALSE(precedence.IsUpdateValid({47, 120, 75}));
+
+  REQUIRE_THROWS_AS(PrecedenceMatrix(Rules{{1, 100}}), std::out_of_range);
+  REQUIRE(PrecedenceMatrix<128>(Rules{{1, 100}}).MustPrecede(1, 100));
+}
+
 TEST_CASE("Task day 5")
 {
   std::ifstream data("data.txt");
@@ -167,11 +247,29 @@ TEST_CASE("Task day 5")
 
   SECTION("part 1")
   {
-    std::cout << "Day 5 - part 1 result: " << SumMidElementOfValidUpdates(rules, updates) << std::endl;
+    ReportResult(5, 1, [&]
+                       { return SumMidElementOfValidUpdates(rules, updates); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 5 - part 2 result: " << SumMidElementOfNotValidUpdates(rules, updates) << std::endl;
+    ReportResult(5, 2, [&]
+                       { return SumMidElementOfNotValidUpdates(rules, updates); });
   }
+}
+
+TEST_CASE("Batch day 5")
+{
+  auto part1 = [](std::istream &input)
+  {
+    const auto &[rules, updates] = ReadRulesAndUpdates(input);
+    return SumMidElementOfValidUpdates(rules, updates);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    const auto &[rules, updates] = ReadRulesAndUpdates(input);
+    return SumMidElementOfNotValidUpdates(rules, updates);
+  };
+
+  RunBatch(5, part1, part2);
 }
\ No newline at end of file
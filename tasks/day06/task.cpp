@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <numeric>
 #include <unordered_set>
@@ -15,28 +17,10 @@ constexpr auto testData = R"(....#.....
 #.........
 ......#...)";
 
-struct Point
-{
-  size_t row;
-  size_t column;
-
-  auto operator<=>(const Point &) const = default;
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    std::size_t operator()(const Point &p) const
-    {
-      std::size_t h1 = std::hash<size_t>{}(p.row);
-      std::size_t h2 = std::hash<size_t>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::Direction;
+using aoc::IsInside;
+using aoc::Point;
+using aoc::TurnRight;
 
 struct LabMapWalker
 {
@@ -44,11 +28,11 @@ struct LabMapWalker
   {
     std::string line;
 
-    size_t row = 0;
+    int row = 0;
 
     while (std::getline(input, line))
     {
-      size_t column = 0;
+      int column = 0;
       for (const auto &c : line)
       {
         if (c == '#')
@@ -63,14 +47,14 @@ struct LabMapWalker
         ++column;
       }
       ++row;
-      max_column = line.size() - 1;
+      max_column = static_cast<int>(line.size()) - 1;
     }
     max_row = row - 1;
   }
 
   LabMapWalker(
-      const size_t &max_column_,
-      const size_t &max_row_,
+      const int &max_column_,
+      const int &max_row_,
       const std::unordered_set<Point> &obstructionPoints_,
       const Point &startPosition_,
       const Point &additionalObstruction)
@@ -85,72 +69,17 @@ struct LabMapWalker
 
   void Walk()
   {
-    if (currentDirection == 'u')
-    {
-      currentPosition = {currentPosition.row - 1, currentPosition.column};
-    }
-    else if (currentDirection == 'r')
-    {
-      currentPosition = {currentPosition.row, currentPosition.column + 1};
-    }
-    else if (currentDirection == 'd')
-    {
-      currentPosition = {currentPosition.row + 1, currentPosition.column};
-    }
-    else if (currentDirection == 'l')
-    {
-      currentPosition = {currentPosition.row, currentPosition.column - 1};
-    }
+    currentPosition = currentPosition.Neighbour(currentDirection);
   };
 
   bool IsNotGoingOutside()
   {
-    if (currentDirection == 'u' && currentPosition.row == 0)
-    {
-      return false;
-    }
-
-    if (currentDirection == 'r' && currentPosition.column == max_column)
-    {
-      return false;
-    }
-
-    if (currentDirection == 'd' && currentPosition.row == max_row)
-    {
-      return false;
-    }
-
-    if (currentDirection == 'l' && currentPosition.column == 0)
-    {
-      return false;
-    }
-
-    return true;
+    return IsInside(currentPosition.Neighbour(currentDirection), max_row + 1, max_column + 1);
   }
 
   bool CanWalkInCurrentDirection()
   {
-    if (currentDirection == 'u' && !obstructionPoints.contains({currentPosition.row - 1, currentPosition.column}))
-    {
-      return true;
-    }
-
-    if (currentDirection == 'r' && !obstructionPoints.contains({currentPosition.row, currentPosition.column + 1}))
-    {
-      return true;
-    }
-
-    if (currentDirection == 'd' && !obstructionPoints.contains({currentPosition.row + 1, currentPosition.column}))
-    {
-      return true;
-    }
-
-    if (currentDirection == 'l' && !obstructionPoints.contains({currentPosition.row, currentPosition.column - 1}))
-    {
-      return true;
-    }
-
-    return false;
+    return !obstructionPoints.contains(currentPosition.Neighbour(currentDirection));
   }
 
   int CountMapWalkPoints()
@@ -169,7 +98,7 @@ struct LabMapWalker
       }
       else
       {
-        currentDirection = directionChange.at(currentDirection);
+        currentDirection = TurnRight(currentDirection);
       }
     }
     visitedPoints[currentPosition] = currentDirection;
@@ -196,22 +125,15 @@ struct LabMapWalker
     return count;
   }
 
-  size_t max_column;
-  size_t max_row;
+  int max_column;
+  int max_row;
 
   std::unordered_set<Point> obstructionPoints;
-  std::unordered_map<Point, char> visitedPoints;
+  std::unordered_map<Point, Direction> visitedPoints;
   Point startPosition;
   Point currentPosition;
-  char startDirection{'u'};
-  char currentDirection{'u'};
-
-  const std::unordered_map<char, char> directionChange =
-      {
-          {'u', 'r'},
-          {'r', 'd'},
-          {'d', 'l'},
-          {'l', 'u'}};
+  Direction startDirection{Direction::Up};
+  Direction currentDirection{Direction::Up};
 };
 
 TEST_CASE("Check with test data")
@@ -232,7 +154,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 6")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -241,11 +162,27 @@ TEST_CASE("Task day 6")
 
   SECTION("part 1")
   {
-    std::cout << "Day 6 - part 1 result: " << labMap.CountMapWalkPoints() << std::endl;
+    ReportResult(6, 1, [&]
+                       { return labMap.CountMapWalkPoints(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 6 - part 2 result: " << labMap.CountPossibleLoopObstructions() << std::endl;
+    ReportResult(6, 2, [&]
+                       { return labMap.CountPossibleLoopObstructions(); });
   }
+}
+
+TEST_CASE("Batch day 6")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return LabMapWalker{input}.CountMapWalkPoints();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return LabMapWalker{input}.CountPossibleLoopObstructions();
+  };
+
+  RunBatch(6, part1, part2);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <regex>
 #include <fstream>
 
@@ -154,18 +155,33 @@ uint64_t SumTestNumbersWithConcatenation(std::istream &input)
 
 TEST_CASE("Task day 7")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("part 1")
   {
-    std::cout << "Day 7 - part 1 result: " << SumTestNumbers(data) << std::endl;
+    ReportResult(7, 1, [&]
+                       { return SumTestNumbers(data); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 7 - part 2 result: " << SumTestNumbersWithConcatenation(data) << std::endl;
+    ReportResult(7, 2, [&]
+                       { return SumTestNumbersWithConcatenation(data); });
   }
+}
+
+TEST_CASE("Batch day 7")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return SumTestNumbers(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return SumTestNumbersWithConcatenation(input);
+  };
+
+  RunBatch(7, part1, part2);
 }
\ No newline at end of file
@@ -1,9 +1,10 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <numeric>
 #include <unordered_set>
-#include <utils/Timer.h>
 
 constexpr auto testData = R"(............
 ........0...
@@ -18,28 +19,8 @@ constexpr auto testData = R"(............
 ............
 ............)";
 
-struct Point
-{
-  int row;
-  int column;
-
-  auto operator<=>(const Point &) const = default;
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    int operator()(const Point &p) const
-    {
-      int h1 = std::hash<int>{}(p.row);
-      int h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::IsInside;
+using aoc::Point;
 
 struct AntennaMap
 {
@@ -78,11 +59,8 @@ struct AntennaMap
           continue;
         }
 
-        int diffX = otherPoint.column - point.column;
-        int diffY = otherPoint.row - point.row;
-
-        Point p = {otherPoint.row + diffY, otherPoint.column + diffX};
-        if (p.row >= 0 && p.row <= max_row && p.column >= 0 && p.column <= max_column)
+        const Point p = otherPoint + (otherPoint - point);
+        if (IsInside(p, max_row + 1, max_column + 1))
         {
           antinodes.insert(p);
         }
@@ -104,12 +82,8 @@ struct AntennaMap
           continue;
         }
 
-        int diffX = otherPoint.column - point.column;
-        int diffY = otherPoint.row - point.row;
-
-        for (Point p = {otherPoint.row, otherPoint.column};
-             p.row >= 0 && p.row <= max_row && p.column >= 0 && p.column <= max_column;
-             p.row += diffY, p.column += diffX)
+        const Point diff = otherPoint - point;
+        for (Point p = otherPoint; IsInside(p, max_row + 1, max_column + 1); p = p + diff)
         {
           antinodes.insert(p);
         }
@@ -143,7 +117,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 8")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -152,11 +125,27 @@ TEST_CASE("Task day 8")
 
   SECTION("part 1")
   {
-    std::cout << "Day 8 - part 1 result: " << map.CountAntinodes() << std::endl;
+    ReportResult(8, 1, [&]
+                       { return map.CountAntinodes(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 8 - part 2 result: " << map.CountAntinodesWithHarmonics() << std::endl;
+    ReportResult(8, 2, [&]
+                       { return map.CountAntinodesWithHarmonics(); });
   }
+}
+
+TEST_CASE("Batch day 8")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return AntennaMap{input}.CountAntinodes();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return AntennaMap{input}.CountAntinodesWithHarmonics();
+  };
+
+  RunBatch(8, part1, part2);
 }
\ No newline at end of file
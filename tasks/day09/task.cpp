@@ -1,8 +1,8 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <fstream>
 #include <list>
-#include <utils/Timer.h>
 
 constexpr auto testData = "2333133121414131402";
 
@@ -145,7 +145,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 9")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -154,11 +153,27 @@ TEST_CASE("Task day 9")
 
   SECTION("part 1")
   {
-    std::cout << "Day 9 - part 1 result: " << disk.GetFilesystemChecksum() << std::endl;
+    ReportResult(9, 1, [&]
+                       { return disk.GetFilesystemChecksum(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 9 - part 2 result: " << disk.GetFilesystemChecksumWithWholeBlocks() << std::endl;
+    ReportResult(9, 2, [&]
+                       { return disk.GetFilesystemChecksumWithWholeBlocks(); });
   }
+}
+
+TEST_CASE("Batch day 9")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return Disk{input}.GetFilesystemChecksum();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return Disk{input}.GetFilesystemChecksumWithWholeBlocks();
+  };
+
+  RunBatch(9, part1, part2);
 }
\ No newline at end of file
@@ -1,6 +1,14 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
+#include <set>
+
+using aoc::GridLayout;
+using aoc::IsInside;
+using aoc::Point;
+using aoc::straightDirections;
 
 constexpr auto testData = R"(89010123
 78121874
@@ -11,123 +19,89 @@ constexpr auto testData = R"(89010123
 01329801
 10456732)";
 
-struct Point
-{
-  int row;
-  int column;
-  auto operator<=>(const Point &) const = default;
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    int operator()(const Point &p) const
-    {
-      int h1 = std::hash<int>{}(p.row);
-      int h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
-
 struct HikingMap
 {
   HikingMap(std::istream &input)
   {
+    std::vector<std::string> lines;
     std::string line;
 
-    int row = 0;
-
     while (std::getline(input, line))
     {
-      int column = 0;
-      for (const auto &c : line)
+      columns = std::max(columns, static_cast<int>(line.size()));
+      lines.push_back(line);
+    }
+    rows = static_cast<int>(lines.size());
+
+    layout = GridLayout(rows, columns);
+    heights.assign(layout.Size(), -1);
+
+    for (int row = 0; row < rows; ++row)
+    {
+      for (int column = 0; column < static_cast<int>(lines[row].size()); ++column)
       {
-        if (c != '.')
+        if (const char c = lines[row][column]; c != '.')
         {
-          pointsHeights.try_emplace({row, column}, c - '0');
+          heights[layout.ToIndex({row, column})] = c - '0';
         }
-        ++column;
       }
-      ++row;
     }
   }
 
+  int GetHeight(const Point &p) const
+  {
+    return IsInside(p, rows, columns) ? heights[layout.ToIndex(p)] : -1;
+  }
+
   void FindTopsForTrailhead(const Point &currentPoint, std::set<Point> &tops)
   {
-    if (pointsHeights[currentPoint] == 9)
+    if (GetHeight(currentPoint) == 9)
     {
       tops.emplace(currentPoint);
       return;
     }
-    if (Point upPoint{currentPoint.row + 1, currentPoint.column};
-        IsHigherThan(upPoint, currentPoint))
-    {
-      FindTopsForTrailhead(upPoint, tops);
-    }
-    if (Point rightPoint{currentPoint.row, currentPoint.column + 1};
-        IsHigherThan(rightPoint, currentPoint))
-    {
-      FindTopsForTrailhead(rightPoint, tops);
-    }
-    if (Point bottomPoint{currentPoint.row - 1, currentPoint.column};
-        IsHigherThan(bottomPoint, currentPoint))
-    {
-      FindTopsForTrailhead(bottomPoint, tops);
-    }
-    if (Point leftPoint{currentPoint.row, currentPoint.column - 1};
-        IsHigherThan(leftPoint, currentPoint))
+    for (const auto direction : straightDirections)
     {
-      FindTopsForTrailhead(leftPoint, tops);
+      if (const auto next = currentPoint.Neighbour(direction);
+          IsHigherThan(next, currentPoint))
+      {
+        FindTopsForTrailhead(next, tops);
+      }
     }
   }
 
-  int CalcTrailheadRating(const auto &currentPoint)
+  int CalcTrailheadRating(const Point &currentPoint)
   {
-    int sum = 0;
-    if (pointsHeights[currentPoint] == 9)
+    if (GetHeight(currentPoint) == 9)
     {
       return 1;
     }
-    if (Point upPoint{currentPoint.row + 1, currentPoint.column};
-        IsHigherThan(upPoint, currentPoint))
-    {
-      sum += CalcTrailheadRating(upPoint);
-    }
-    if (Point rightPoint{currentPoint.row, currentPoint.column + 1};
-        IsHigherThan(rightPoint, currentPoint))
-    {
-      sum += CalcTrailheadRating(rightPoint);
-    }
-    if (Point bottomPoint{currentPoint.row - 1, currentPoint.column};
-        IsHigherThan(bottomPoint, currentPoint))
-    {
-      sum += CalcTrailheadRating(bottomPoint);
-    }
-    if (Point leftPoint{currentPoint.row, currentPoint.column - 1};
-        IsHigherThan(leftPoint, currentPoint))
+    int sum = 0;
+    for (const auto direction : straightDirections)
     {
-      sum += CalcTrailheadRating(leftPoint);
+      if (const auto next = currentPoint.Neighbour(direction);
+          IsHigherThan(next, currentPoint))
+      {
+        sum += CalcTrailheadRating(next);
+      }
     }
     return sum;
   }
 
-  bool IsHigherThan(const Point &l, const Point &r)
+  bool IsHigherThan(const Point &l, const Point &r) const
   {
-    return pointsHeights.contains(l) && (pointsHeights[l] > pointsHeights[r]) && (pointsHeights[l] - pointsHeights[r]) == 1;
+    const int height = GetHeight(l);
+    return height >= 0 && height - GetHeight(r) == 1;
   }
 
   int CalcTrailheadsRating()
   {
     int sum = 0;
-    for (const auto &[point, height] : pointsHeights)
+    for (size_t index = 0; index < heights.size(); ++index)
     {
-      if (height == 0)
+      if (heights[index] == 0)
       {
-        sum += CalcTrailheadRating(point);
+        sum += CalcTrailheadRating(layout.FromIndex(index));
       }
     }
     return sum;
@@ -136,19 +110,23 @@ struct HikingMap
   int CountTopsForTrailhead()
   {
     int sum = 0;
-    for (const auto &[point, height] : pointsHeights)
+    for (size_t index = 0; index < heights.size(); ++index)
     {
-      if (height == 0)
+      if (heights[index] == 0)
       {
         std::set<Point> tops;
-        FindTopsForTrailhead(point, tops);
+        FindTopsForTrailhead(layout.FromIndex(index), tops);
         sum += static_cast<int>(tops.size());
       }
     }
     return sum;
   }
 
-  std::unordered_map<Point, int> pointsHeights;
+  int rows = 0;
+  int columns = 0;
+  GridLayout layout{0, 0};
+  // Heights in layout order, usually Z-order, cells without a height hold -1.
+  std::vector<int8_t> heights;
 };
 
 TEST_CASE("Check with test data")
@@ -169,7 +147,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 10")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -178,11 +155,27 @@ TEST_CASE("Task day 10")
 
   SECTION("part 1")
   {
-    std::cout << "Day 10 - part 1 result: " << map.CountTopsForTrailhead() << std::endl;
+    ReportResult(10, 1, [&]
+                        { return map.CountTopsForTrailhead(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 10 - part 2 result: " << map.CalcTrailheadsRating() << std::endl;
+    ReportResult(10, 2, [&]
+                        { return map.CalcTrailheadsRating(); });
   }
+}
+
+TEST_CASE("Batch day 10")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return HikingMap{input}.CountTopsForTrailhead();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return HikingMap{input}.CalcTrailheadsRating();
+  };
+
+  RunBatch(10, part1, part2);
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
-#include <utils/Timer.h>
+#include <utils/MemoCache.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 
 constexpr auto testData = "125 17";
 
@@ -30,7 +32,7 @@ namespace std
 class StonesSplitter
 {
 public:
-  StonesSplitter(std::istream &input)
+  StonesSplitter(std::istream &input, size_t cacheCapacity = 0) : blinksCache(cacheCapacity)
   {
     uint64_t val;
     while (input >> val)
@@ -80,15 +82,10 @@ public:
       {
         sum += 1;
       }
-      else if (cahceBlinks.contains(StoneToBlinks{id, blinksLeft}))
-      {
-        sum += cahceBlinks[StoneToBlinks{id, blinksLeft}];
-      }
       else
       {
-        const auto count = CountSplittedStones(SplitStone(id), blinksLeft - 1);
-        cahceBlinks[StoneToBlinks{id, blinksLeft}] = count;
-        sum += count;
+        sum += blinksCache.GetOrCompute(StoneToBlinks{id, blinksLeft}, [&]
+                                        { return CountSplittedStones(SplitStone(id), blinksLeft - 1); });
       }
     }
     return sum;
@@ -100,7 +97,7 @@ public:
   }
 
   std::vector<uint64_t> ids;
-  std::unordered_map<StoneToBlinks, uint64_t> cahceBlinks;
+  MemoCache<StoneToBlinks, uint64_t> blinksCache;
 };
 
 TEST_CASE("Check with test data")
@@ -111,12 +108,22 @@ TEST_CASE("Check with test data")
   SECTION("Part 1")
   {
     REQUIRE(55312u == splitter.CountStones(25));
+    REQUIRE(splitter.blinksCache.GetStats().hits > 0);
   }
 }
 
+TEST_CASE("Check with bounded cache")
+{
+  std::stringstream testInput{testData};
+  StonesSplitter splitter{testInput, 16};
+
+  REQUIRE(55312u == splitter.CountStones(25));
+  REQUIRE(16u == splitter.blinksCache.Size());
+  REQUIRE(splitter.blinksCache.GetStats().evictions > 0);
+}
+
 TEST_CASE("Task day 11")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -125,11 +132,28 @@ TEST_CASE("Task day 11")
 
   SECTION("part 1")
   {
-    std::cout << "Day 11 - part 1 result: " << splitter.CountStones(25) << std::endl;
+    ReportResult(11, 1, [&]
+                        { return splitter.CountStones(25); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 11 - part 2 result: " << splitter.CountStones(75) << std::endl;
+    ReportResult(11, 2, [&]
+                        { return splitter.CountStones(75); });
+    ReportCacheStats(11, "blinks", splitter.blinksCache.GetStats());
   }
 }
+
+TEST_CASE("Batch day 11")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return StonesSplitter{input}.CountStones(25);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return StonesSplitter{input}.CountStones(75);
+  };
+
+  RunBatch(11, part1, part2);
+}
@@ -1,69 +1,15 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <unordered_set>
 #include <fstream>
 
-struct Point
-{
-  int row;
-  int column;
-
-  auto operator<=>(const Point &) const = default;
-
-  Point PointUp() const
-  {
-    return Point{row + 1, column};
-  }
-
-  Point PointUpLeft() const
-  {
-    return Point{row + 1, column - 1};
-  }
-
-  Point PointUpRight() const
-  {
-    return Point{row + 1, column + 1};
-  }
-
-  Point PointDown() const
-  {
-    return Point{row - 1, column};
-  }
-
-  Point PointDownLeft() const
-  {
-    return Point{row - 1, column - 1};
-  }
-
-  Point PointDownRight() const
-  {
-    return Point{row - 1, column + 1};
-  }
-
-  Point PointLeft() const
-  {
-    return Point{row, column - 1};
-  }
-  Point PointRight() const
-  {
-    return Point{row, column + 1};
-  }
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    int operator()(const Point &p) const
-    {
-      int h1 = std::hash<int>{}(p.row);
-      int h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::Direction;
+using aoc::GridLayout;
+using aoc::IsInside;
+using aoc::Point;
+using aoc::straightDirections;
 
 struct Group
 {
@@ -74,11 +20,9 @@ struct Group
     size_t perimeter = 0;
     for (const auto &p : points)
     {
-      std::vector<Point> siblings{p.PointDown(), p.PointLeft(), p.PointRight(), p.PointUp()};
-
-      for (const auto &sibling : siblings)
+      for (const auto direction : straightDirections)
       {
-        if (!points.contains(sibling))
+        if (!points.contains(p.Neighbour(direction)))
         {
           ++perimeter;
         }
@@ -87,20 +31,6 @@ struct Group
     return perimeter;
   }
 
-  std::unordered_map<std::string, Point> GetSiblings(const Point &p) const
-  {
-    std::unordered_map<std::string, Point> siblings{
-        {"UpLeft", p.PointUpLeft()},
-        {"Up", p.PointUp()},
-        {"UpRight", p.PointUpRight()},
-        {"Left", p.PointLeft()},
-        {"Right", p.PointRight()},
-        {"Down", p.PointDown()},
-        {"DownLeft", p.PointDownLeft()},
-        {"DownRight", p.PointDownRight()}};
-    return siblings;
-  }
-
   bool IsOutCorner(const Point &horizontal, const Point &vertical) const
   {
     return !points.contains(horizontal) && !points.contains(vertical);
@@ -113,12 +43,19 @@ struct Group
 
   size_t CountCorners(const Point &p) const
   {
-    const auto &siblings = GetSiblings(p);
+    constexpr std::array<std::array<Direction, 3>, 4> cornerDirections{{
+        {Direction::Left, Direction::Up, Direction::UpLeft},
+        {Direction::Right, Direction::Up, Direction::UpRight},
+        {Direction::Left, Direction::Down, Direction::DownLeft},
+        {Direction::Right, Direction::Down, Direction::DownRight},
+    }};
+
     size_t corners = 0;
-    corners += IsOutCorner(siblings.at("Left"), siblings.at("Up")) || IsInCorner(siblings.at("Left"), siblings.at("Up"), siblings.at("UpLeft"));
-    corners += IsOutCorner(siblings.at("Right"), siblings.at("Up")) || IsInCorner(siblings.at("Right"), siblings.at("Up"), siblings.at("UpRight"));
-    corners += IsOutCorner(siblings.at("Left"), siblings.at("Down")) || IsInCorner(siblings.at("Left"), siblings.at("Down"), siblings.at("DownLeft"));
-    corners += IsOutCorner(siblings.at("Right"), siblings.at("Down")) || IsInCorner(siblings.at("Right"), siblings.at("Down"), siblings.at("DownRight"));
+    for (const auto &[horizontal, vertical, diagonal] : cornerDirections)
+    {
+      corners += IsOutCorner(p.Neighbour(horizontal), p.Neighbour(vertical)) ||
+                 IsInCorner(p.Neighbour(horizontal), p.Neighbour(vertical), p.Neighbour(diagonal));
+    }
     return corners;
   }
 
@@ -144,44 +81,40 @@ struct GardenMap
 {
   GardenMap(std::istream &input)
   {
+    std::vector<std::string> lines;
     std::string line;
 
-    int row = 0;
-
     while (std::getline(input, line))
     {
-      int column = 0;
-      for (const auto &c : line)
-      {
-        if (c != '.')
-        {
-          pointsHeights.emplace(Point{row, column}, c);
-        }
-        ++column;
-      }
-      ++row;
+      columns = std::max(columns, static_cast<int>(line.size()));
+      lines.push_back(line);
     }
+    rows = static_cast<int>(lines.size());
 
-    for (const auto &[p, type] : pointsHeights)
+    layout = GridLayout(rows, columns);
+    plots.assign(layout.Size(), '.');
+    grouped.assign(plots.size(), false);
+
+    for (int row = 0; row < rows; ++row)
     {
-      if (InAnyGroup(p))
+      for (int column = 0; column < static_cast<int>(lines[row].size()); ++column)
       {
-        continue;
+        plots[layout.ToIndex({row, column})] = lines[row][column];
       }
-      CreateGroup(p);
     }
-  }
 
-  bool InAnyGroup(const Point &p)
-  {
-    for (const auto &g : groups)
+    for (size_t index = 0; index < plots.size(); ++index)
     {
-      if (g.points.contains(p))
+      if (plots[index] != '.' && !grouped[index])
       {
-        return true;
+        CreateGroup(layout.FromIndex(index));
       }
     }
-    return false;
+  }
+
+  char GetPlot(const Point &p) const
+  {
+    return IsInside(p, rows, columns) ? plots[layout.ToIndex(p)] : '.';
   }
 
   void CreateGroup(const Point &p)
@@ -189,18 +122,18 @@ struct GardenMap
     Group g;
     AddGroupMembers(p, g);
 
-    groups.emplace_back(g);
+    groups.emplace_back(std::move(g));
   }
 
   void AddGroupMembers(const Point &p, Group &group)
   {
     group.points.emplace(p);
+    grouped[layout.ToIndex(p)] = true;
 
-    std::vector<Point> siblings{p.PointDown(), p.PointLeft(), p.PointRight(), p.PointUp()};
-
-    for (const auto &sibling : siblings)
+    for (const auto direction : straightDirections)
     {
-      if (pointsHeights.contains(sibling) && pointsHeights[p] == pointsHeights[sibling] && !group.points.contains(sibling))
+      if (const auto sibling = p.Neighbour(direction);
+          GetPlot(sibling) == GetPlot(p) && !grouped[layout.ToIndex(sibling)])
       {
         AddGroupMembers(sibling, group);
       }
@@ -227,7 +160,12 @@ struct GardenMap
     return price;
   }
 
-  std::unordered_map<Point, char> pointsHeights;
+  int rows = 0;
+  int columns = 0;
+  GridLayout layout{0, 0};
+  // Plot types in layout order, usually Z-order, cells outside the garden hold '.'.
+  std::vector<char> plots;
+  std::vector<bool> grouped;
   std::vector<Group> groups;
 };
 
@@ -282,7 +220,6 @@ EEEC)";
 
 TEST_CASE("Task day 12")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -291,11 +228,27 @@ TEST_CASE("Task day 12")
 
   SECTION("part 1")
   {
-    std::cout << "Day 12 - part 1 result: " << map.CalcFencePrice() << std::endl;
+    ReportResult(12, 1, [&]
+                        { return map.CalcFencePrice(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 12 - part 2 result: " << map.CalcFencePriceWithDiscunt() << std::endl;
+    ReportResult(12, 2, [&]
+                        { return map.CalcFencePriceWithDiscunt(); });
   }
+}
+
+TEST_CASE("Batch day 12")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return GardenMap{input}.CalcFencePrice();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return GardenMap{input}.CalcFencePriceWithDiscunt();
+  };
+
+  RunBatch(12, part1, part2);
 }
\ No newline at end of file
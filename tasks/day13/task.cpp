@@ -1,8 +1,12 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Records.h>
 #include <unordered_set>
 #include <regex>
+#include <stdexcept>
+#include <string>
 
 constexpr auto testData = R"(Button A: X+94, Y+34
 Button B: X+22, Y+67
@@ -34,23 +38,34 @@ struct ClawMachineWithLimits
 {
   using PositionsXY = std::pair<int64_t, int64_t>;
 
-  ClawMachineWithLimits(std::istream &input)
+  ClawMachineWithLimits(std::string_view block)
   {
-    std::string line;
-    std::getline(input, line);
-    buttonA = ReadValues(line);
-    std::getline(input, line);
-    buttonB = ReadValues(line);
-    std::getline(input, line);
-    prize = ReadValues(line);
+    auto lines = Lines(block);
+    auto line = lines.begin();
+    auto nextLine = [&]
+    {
+      if (line == lines.end())
+      {
+        // Only the first line, so batch error rows stay on a single line.
+        throw std::runtime_error("Incomplete claw machine starting with: " +
+                                 std::string(block.substr(0, block.find_first_of("\r\n"))));
+      }
+      const auto current = *line;
+      ++line;
+      return current;
+    };
+
+    buttonA = ReadValues(nextLine());
+    buttonB = ReadValues(nextLine());
+    prize = ReadValues(nextLine());
   }
 
-  std::pair<int64_t, int64_t> ReadValues(const std::string &line)
+  std::pair<int64_t, int64_t> ReadValues(std::string_view line)
   {
-    std::regex pattern(R"(X[+=](\d+), Y[+=](\d+))");
-    std::smatch matches;
+    static const std::regex pattern(R"(X[+=](\d+), Y[+=](\d+))");
+    std::cmatch matches;
 
-    if (std::regex_search(line, matches, pattern))
+    if (std::regex_search(line.data(), line.data() + line.size(), matches, pattern))
     {
       int64_t x = std::stoi(matches[1].str());
       int64_t y = std::stoi(matches[2].str());
@@ -108,7 +123,7 @@ struct ClawMachineWithLimits
 
 struct ClawMachine : public ClawMachineWithLimits
 {
-  ClawMachine(std::istream &input) : ClawMachineWithLimits(input)
+  ClawMachine(std::string_view block) : ClawMachineWithLimits(block)
   {
     maxClicks = std::numeric_limits<int64_t>::max();
     prize.first += 10000000000000;
@@ -116,26 +131,28 @@ struct ClawMachine : public ClawMachineWithLimits
   }
 };
 
-size_t CalcRequiredTokensWithLimits(std::istream &input)
+template <typename Machine>
+size_t SumRequiredTokens(std::istream &input)
 {
+  const auto buffer = ReadBuffer(input);
   size_t sum = 0;
-  char c;
-  while (input >> c)
+
+  for (auto &machine : ParseRecords<Machine>(Blocks(buffer), [](std::string_view block)
+                                             { return Machine(block); }))
   {
-    sum += ClawMachineWithLimits(input).CalcRequiredTokens();
+    sum += machine.CalcRequiredTokens();
   }
   return sum;
 }
 
+size_t CalcRequiredTokensWithLimits(std::istream &input)
+{
+  return SumRequiredTokens<ClawMachineWithLimits>(input);
+}
+
 size_t CalcRequiredTokens(std::istream &input)
 {
-  size_t sum = 0;
-  char c;
-  while (input >> c)
-  {
-    sum += ClawMachine(input).CalcRequiredTokens();
-  }
-  return sum;
+  return SumRequiredTokens<ClawMachine>(input);
 }
 
 TEST_CASE("Check with test data")
@@ -148,20 +165,44 @@ TEST_CASE("Check with test data")
   }
 }
 
+TEST_CASE("Check truncated machine")
+{
+  std::stringstream testInput{"Button A: X+94, Y+34\nButton B: X+22, Y+67\nPrize: X=8400, Y=5400\n\n"
+                              "Button A: X+26, Y+66\nButton B: X+67, Y+21\n"};
+
+  REQUIRE_THROWS_WITH(CalcRequiredTokensWithLimits(testInput),
+                      "Incomplete claw machine starting with: Button A: X+26, Y+66");
+}
+
 TEST_CASE("Task day 13")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("part 1")
   {
-    std::cout << "Day 13 - part 1 result: " << CalcRequiredTokensWithLimits(data) << std::endl;
+    ReportResult(13, 1, [&]
+                        { return CalcRequiredTokensWithLimits(data); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 13 - part 2 result: " << CalcRequiredTokens(data) << std::endl;
+    ReportResult(13, 2, [&]
+                        { return CalcRequiredTokens(data); });
   }
 }
+
+TEST_CASE("Batch day 13")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return CalcRequiredTokensWithLimits(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return CalcRequiredTokens(input);
+  };
+
+  RunBatch(13, part1, part2);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <regex>
 
 constexpr auto testData = R"(p=0,4 v=3,-3
@@ -81,13 +82,12 @@ size_t CountRobotsInQuadrants(std::istream &input, int limitX, int limitY)
   return q1 * q2 * q3 * q4;
 }
 
-void PrintPositions(int limitX, int limitY, int iterations)
+void PrintPositions(std::ostream &output, int limitX, int limitY, int iterations)
 {
-  Timer t;
   std::string line;
   for (int i = 0; i < iterations; ++i)
   {
-    std::cout << "Iteration: " << i << std::endl;
+    output << "Iteration: " << i << std::endl;
     std::ifstream data("data.txt");
     std::set<std::pair<int, int>> points;
     while (std::getline(data, line))
@@ -100,16 +100,16 @@ void PrintPositions(int limitX, int limitY, int iterations)
       {
         if (points.contains({x, y}))
         {
-          std::cout << '*';
+          output << '*';
         }
         else
         {
-          std::cout << '.';
+          output << '.';
         }
       }
-      std::cout << std::endl;
+      output << std::endl;
     }
-    std::cout << std::endl;
+    output << std::endl;
   }
 }
 
@@ -121,19 +121,32 @@ TEST_CASE("Check witch example data")
 
 TEST_CASE("Task day 14")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("part 1")
   {
-    std::cout << "Day 14 - part 1 result: " << CountRobotsInQuadrants(data, 101, 103) << std::endl;
+    ReportResult(14, 1, [&]
+                        { return CountRobotsInQuadrants(data, 101, 103); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 14 - part 2 result: " << std::endl;
-    PrintPositions(101, 103, 10000);
+    // The answer is read off the pictures, which go to stderr in JSON mode to keep
+    // stdout a stream of result lines.
+    auto &output = GetResultFormat() == ResultFormat::Json ? std::cerr : std::cout;
+    output << "Day 14 - part 2 result: " << std::endl;
+    PrintPositions(output, 101, 103, 10000);
   }
 }
+
+TEST_CASE("Batch day 14")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return CountRobotsInQuadrants(input, 101, 103);
+  };
+
+  RunBatch(14, part1);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <unordered_set>
 
@@ -36,47 +38,8 @@ vvv<<^>^v^^><<>>><>^<<><^vv^^<>vvv<>><^^v>^>vv<>v<<<<v<^v>^<^^>>>^<v<v
 ^^>vv<^v^v<vv>^<><v<^v>^^^>>>^^vvv^>vvv<>>>^<^>>>>>^<<^v>^vvv<>^<><<v>
 v^^>>><<^^<>>^v^<v^vv<>v^<<>^<^v^v><^<<<><<^<v><v<>vv>>v><v^<vv<>v^<<^)";
 
-struct Point
-{
-  int column;
-  int row;
-
-  auto operator<=>(const Point &) const = default;
-
-  Point PointUp() const
-  {
-    return Point{column, row - 1};
-  }
-
-  Point PointDown() const
-  {
-    return Point{column, row + 1};
-  }
-
-  Point PointLeft() const
-  {
-    return Point{column - 1, row};
-  }
-  Point PointRight() const
-  {
-    return Point{column + 1, row};
-  }
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    int operator()(const Point &p) const
-    {
-      int h1 = std::hash<int>{}(p.row);
-      int h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::Direction;
+using aoc::Point;
 
 struct Warehouse
 {
@@ -90,7 +53,7 @@ struct Warehouse
       int column = 0;
       for (const auto &c : line)
       {
-        const auto newObject = Point{column, row};
+        const auto newObject = Point{row, column};
         if (c == '#')
         {
           wallPoints.emplace(newObject);
@@ -146,19 +109,19 @@ struct Warehouse
     Point newPosition;
     if (direction == '^')
     {
-      newPosition = objectPosition.PointUp();
+      newPosition = objectPosition.Neighbour(Direction::Up);
     }
     else if (direction == '<')
     {
-      newPosition = objectPosition.PointLeft();
+      newPosition = objectPosition.Neighbour(Direction::Left);
     }
     else if (direction == '>')
     {
-      newPosition = objectPosition.PointRight();
+      newPosition = objectPosition.Neighbour(Direction::Right);
     }
     else if (direction == 'v')
     {
-      newPosition = objectPosition.PointDown();
+      newPosition = objectPosition.Neighbour(Direction::Down);
     }
     return newPosition;
   }
@@ -206,7 +169,7 @@ struct Warehouse
     {
       for (int x = 0; x <= max.column; ++x)
       {
-        Point p{x, y};
+        Point p{y, x};
         if (wallPoints.contains(p))
         {
           std::cout << '#';
@@ -249,9 +212,9 @@ struct WideWarehouse
       int column = 0;
       for (const auto &c : line)
       {
-        const auto newObject = Point{column, row};
+        const auto newObject = Point{row, column};
         ++column;
-        const auto newObject2 = Point{column, row};
+        const auto newObject2 = Point{row, column};
 
         if (c == '#')
         {
@@ -299,19 +262,19 @@ struct WideWarehouse
 
     if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == '[' && direction == '>')
     {
-      return CanMoveInDirection({newPosition.column + 1, newPosition.row}, direction);
+      return CanMoveInDirection(newPosition.Neighbour(Direction::Right), direction);
     }
     if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == ']' && direction == '<')
     {
-      return CanMoveInDirection({newPosition.column - 1, newPosition.row}, direction);
+      return CanMoveInDirection(newPosition.Neighbour(Direction::Left), direction);
     }
     else if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == '[')
     {
-      return CanMoveInDirection(newPosition, direction) && CanMoveInDirection({newPosition.column + 1, newPosition.row}, direction);
+      return CanMoveInDirection(newPosition, direction) && CanMoveInDirection(newPosition.Neighbour(Direction::Right), direction);
     }
     else if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == ']')
     {
-      return CanMoveInDirection(newPosition, direction) && CanMoveInDirection({newPosition.column - 1, newPosition.row}, direction);
+      return CanMoveInDirection(newPosition, direction) && CanMoveInDirection(newPosition.Neighbour(Direction::Left), direction);
     }
 
     return true;
@@ -322,19 +285,19 @@ struct WideWarehouse
     Point newPosition;
     if (direction == '^')
     {
-      newPosition = objectPosition.PointUp();
+      newPosition = objectPosition.Neighbour(Direction::Up);
     }
     else if (direction == '<')
     {
-      newPosition = objectPosition.PointLeft();
+      newPosition = objectPosition.Neighbour(Direction::Left);
     }
     else if (direction == '>')
     {
-      newPosition = objectPosition.PointRight();
+      newPosition = objectPosition.Neighbour(Direction::Right);
     }
     else if (direction == 'v')
     {
-      newPosition = objectPosition.PointDown();
+      newPosition = objectPosition.Neighbour(Direction::Down);
     }
     return newPosition;
   }
@@ -345,12 +308,12 @@ struct WideWarehouse
 
     if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == '[')
     {
-      MoveObject({newPosition.column + 1, newPosition.row}, direction);
+      MoveObject(newPosition.Neighbour(Direction::Right), direction);
       MoveObject(newPosition, direction);
     }
     else if (boxPoints.contains(newPosition) && boxPoints.at(newPosition) == ']')
     {
-      MoveObject({newPosition.column - 1, newPosition.row}, direction);
+      MoveObject(newPosition.Neighbour(Direction::Left), direction);
       MoveObject(newPosition, direction);
     }
 
@@ -392,7 +355,7 @@ struct WideWarehouse
     {
       for (int x = 0; x <= max.column; ++x)
       {
-        Point p{x, y};
+        Point p{y, x};
         if (wallPoints.contains(p))
         {
           std::cout << '#';
@@ -459,7 +422,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 15")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -467,14 +429,38 @@ TEST_CASE("Task day 15")
   SECTION("part 1")
   {
     Warehouse map{data};
-    map.ExecuteMovements();
-    std::cout << "Day 15 - part 1 result: " << map.SumBoxesCoordinates() << std::endl;
+    ReportResult(15, 1, [&]
+                        {
+                          map.ExecuteMovements();
+                          return map.SumBoxesCoordinates();
+                        });
   }
 
   SECTION("part 2")
   {
     WideWarehouse map{data};
-    map.ExecuteMovements();
-    std::cout << "Day 15 - part 2 result: " << map.SumBoxesCoordinates() << std::endl;
+    ReportResult(15, 2, [&]
+                        {
+                          map.ExecuteMovements();
+                          return map.SumBoxesCoordinates();
+                        });
   }
+}
+
+TEST_CASE("Batch day 15")
+{
+  auto part1 = [](std::istream &input)
+  {
+    Warehouse map{input};
+    map.ExecuteMovements();
+    return map.SumBoxesCoordinates();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    WideWarehouse map{input};
+    map.ExecuteMovements();
+    return map.SumBoxesCoordinates();
+  };
+
+  RunBatch(15, part1, part2);
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <unordered_set>
 #include <queue>
@@ -22,47 +24,8 @@ constexpr auto testDataFirst = R"(#################
 #S#.............#
 #################)";
 
-enum class Direction : int
-{
-  N = 0,
-  E = 1,
-  S = 2,
-  W = 3
-};
-
-struct Point
-{
-  int column;
-  int row;
-
-  Point operator+(const Point &other) const
-  {
-    return {column + other.column, row + other.row};
-  }
-
-  auto operator<=>(const Point &) const = default;
-};
-
-const std::unordered_map<Direction, Point> directionDiff{
-    {Direction::N, Point{0, -1}},
-    {Direction::E, Point{1, 0}},
-    {Direction::S, Point{0, 1}},
-    {Direction::W, Point{-1, 0}}};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    size_t operator()(const Point &p) const
-    {
-      size_t h1 = std::hash<int>{}(p.row);
-      size_t h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::Direction;
+using aoc::Point;
 
 struct PointWithDirection
 {
@@ -71,17 +34,17 @@ struct PointWithDirection
 
   PointWithDirection MoveForward() const
   {
-    return {point + directionDiff.at(dir), dir};
+    return {point.Neighbour(dir), dir};
   }
 
   PointWithDirection TurnRight() const
   {
-    return {point, Direction{(static_cast<int>(dir) + 1) % 4}};
+    return {point, aoc::TurnRight(dir)};
   }
 
   PointWithDirection TurnLeft() const
   {
-    return {point, Direction{(static_cast<int>(dir) + 3) % 4}};
+    return {point, aoc::TurnLeft(dir)};
   }
 
   auto operator<=>(const PointWithDirection &) const = default;
@@ -120,7 +83,7 @@ struct Map
       int column = 0;
       for (const auto &c : line)
       {
-        const auto &p = Point{column, row};
+        const auto &p = Point{row, column};
         if (c == '#')
         {
           wallPoints.emplace(p);
@@ -142,7 +105,7 @@ struct Map
   size_t Dijkstra()
   {
     std::priority_queue<std::pair<int64_t, PointWithDirection>, std::vector<std::pair<int64_t, PointWithDirection>>, ComparePair> queue;
-    queue.push({0, {startPosition, Direction::E}});
+    queue.push({0, {startPosition, Direction::Right}});
     std::unordered_map<PointWithDirection, int64_t> visited;
 
     while (!queue.empty())
@@ -194,7 +157,7 @@ struct Map2
       int column = 0;
       for (const auto &c : line)
       {
-        const auto &p = Point{column, row};
+        const auto &p = Point{row, column};
         if (c == '#')
         {
           wallPoints.emplace(p);
@@ -216,9 +179,9 @@ struct Map2
   size_t Dijkstra()
   {
     std::priority_queue<std::pair<int64_t, PointWithDirection>, std::vector<std::pair<int64_t, PointWithDirection>>, ComparePair> queue;
-    queue.push({0, {startPosition, Direction::E}});
+    queue.push({0, {startPosition, Direction::Right}});
     std::unordered_map<PointWithDirection, int64_t> visited;
-    visited[{startPosition, Direction::E}] = 0;
+    visited[{startPosition, Direction::Right}] = 0;
 
     while (!queue.empty())
     {
@@ -274,13 +237,13 @@ struct Map2
       }
     }
 
-    if (visited.at({endPosition, Direction::E}) < visited.at({endPosition, Direction::N}))
+    if (visited.at({endPosition, Direction::Right}) < visited.at({endPosition, Direction::Up}))
     {
-      solution = {endPosition, Direction::E};
+      solution = {endPosition, Direction::Right};
     }
     else
     {
-      solution = {endPosition, Direction::N};
+      solution = {endPosition, Direction::Up};
     }
 
     return std::numeric_limits<size_t>::max();
@@ -355,7 +318,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 16")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -363,13 +325,33 @@ TEST_CASE("Task day 16")
   SECTION("part 1")
   {
     Map map{data};
-    std::cout << "Day 16 - part 1 result: " << map.Dijkstra() << std::endl;
+    ReportResult(16, 1, [&]
+                        { return map.Dijkstra(); });
   }
 
   SECTION("part 2")
   {
     Map2 map{data};
-    map.Dijkstra();
-    std::cout << "Day 16 - part 2 result: " << map.CountOptimalPoints() << std::endl;
+    ReportResult(16, 2, [&]
+                        {
+                          map.Dijkstra();
+                          return map.CountOptimalPoints();
+                        });
   }
+}
+
+TEST_CASE("Batch day 16")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return Map{input}.Dijkstra();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    Map2 map{input};
+    map.Dijkstra();
+    return map.CountOptimalPoints();
+  };
+
+  RunBatch(16, part1, part2);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <fstream>
 #include <unordered_set>
 #include <format>
@@ -237,7 +238,6 @@ struct Computer3Bit
       auto str = comp.Process();
       if (currentProgramPos == 0)
       {
-        std::cout << str << std::endl;
         if (str == expected)
         {
           solution = (currentRegA << 3) + i;
@@ -344,7 +344,6 @@ Program: 0,1,5,4,3,0)";
 
   SECTION("Example 7")
   {
-    Timer t;
     constexpr auto testData = R"(Register A: 2024
 Register B: 0
 Register C: 0
@@ -358,7 +357,6 @@ Program: 0,3,5,4,3,0)";
 
 TEST_CASE("Task day 17")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -366,12 +364,28 @@ TEST_CASE("Task day 17")
   SECTION("part 1")
   {
     Computer3Bit c{data};
-    std::cout << "Day 17 - part 1 result: " << c.Process() << std::endl;
+    ReportResult(17, 1, [&]
+                        { return c.Process(); });
   }
 
   SECTION("part 2")
   {
     Computer3Bit c{data};
-    std::cout << "Day 17 - part 2 result: " << c.ProcessFind() << std::endl;
+    ReportResult(17, 2, [&]
+                        { return c.ProcessFind(); });
   }
+}
+
+TEST_CASE("Batch day 17")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return Computer3Bit{input}.Process();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return Computer3Bit{input}.ProcessFind();
+  };
+
+  RunBatch(17, part1, part2);
 }
\ No newline at end of file
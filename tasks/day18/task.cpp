@@ -1,5 +1,8 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
+#include <utils/Records.h>
 #include <fstream>
 #include <unordered_set>
 #include <queue>
@@ -30,55 +33,15 @@ constexpr auto testData = R"(5,4
 1,6
 2,0)";
 
-struct Point
-{
-  Point() = default;
-  Point(int x, int y) : column(x), row(y) {}
-  Point(const std::string &line)
-  {
-    auto pos = line.find(',');
-    column = std::stoi(line.substr(0, pos));
-    row = std::stoi(line.substr(pos + 1));
-  }
-
-  int column;
-  int row;
-
-  auto operator<=>(const Point &) const = default;
-
-  Point PointUp() const
-  {
-    return Point{column, row - 1};
-  }
-
-  Point PointDown() const
-  {
-    return Point{column, row + 1};
-  }
-
-  Point PointLeft() const
-  {
-    return Point{column - 1, row};
-  }
-  Point PointRight() const
-  {
-    return Point{column + 1, row};
-  }
-};
+using aoc::IsInside;
+using aoc::Point;
+using aoc::straightDirections;
 
-namespace std
+// Bytes are given as "X,Y", that is column first.
+Point ParsePoint(const std::string &line)
 {
-  template <>
-  struct hash<Point>
-  {
-    int operator()(const Point &p) const
-    {
-      int h2 = std::hash<int>{}(p.column);
-      int h1 = std::hash<int>{}(p.row);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
+  auto pos = line.find(',');
+  return {std::stoi(line.substr(pos + 1)), std::stoi(line.substr(0, pos))};
 }
 
 struct ComparePair
@@ -91,14 +54,14 @@ struct ComparePair
 
 struct Map
 {
-  Map(std::istream &input, int xLimit_, int yLimit_, size_t numOfObstacles) : xLimit(xLimit_), yLimit(yLimit_), endPosition(Point{xLimit, yLimit})
+  Map(std::istream &input, int xLimit_, int yLimit_, size_t numOfObstacles) : xLimit(xLimit_), yLimit(yLimit_), endPosition(Point{yLimit, xLimit})
   {
     std::string line;
     size_t num = 0;
 
     while (std::getline(input, line) && num < numOfObstacles)
     {
-      last = Point{line};
+      last = ParsePoint(line);
       wallPoints.emplace(last);
       ++num;
     }
@@ -126,28 +89,13 @@ struct Map
       }
       visited[point] = cost;
 
-      if (const auto &p = point.PointUp();
-          point.row > 0 && !wallPoints.contains(p))
+      for (const auto direction : straightDirections)
       {
-        queue.push({cost + 1, p});
-      }
-
-      if (const auto &p = point.PointDown();
-          point.row < yLimit && !wallPoints.contains(p))
-      {
-        queue.push({cost + 1, p});
-      }
-
-      if (const auto &p = point.PointLeft();
-          point.column > 0 && !wallPoints.contains(p))
-      {
-        queue.push({cost + 1, p});
-      }
-
-      if (const auto &p = point.PointRight();
-          point.column < xLimit && !wallPoints.contains(p))
-      {
-        queue.push({cost + 1, p});
+        if (const auto p = point.Neighbour(direction);
+            IsInside(p, yLimit + 1, xLimit + 1) && !wallPoints.contains(p))
+        {
+          queue.push({cost + 1, p});
+        }
       }
     }
 
@@ -164,11 +112,31 @@ struct Map
 
 TEST_CASE("point")
 {
-  Point p{11, 2};
-  Point p2{"11,2"};
+  Point p{2, 11};
+  Point p2 = ParsePoint("11,2");
   REQUIRE(p == p2);
 }
 
+std::string FindFirstBlockingByte(std::istream &input, int limitX, int limitY)
+{
+  const auto buffer = ReadBuffer(input);
+  Point result{0, 0};
+
+  for (size_t i = 1; i < 3500; ++i)
+  {
+    std::istringstream data{buffer};
+    Map map{data, limitX, limitY, i};
+    if (size_t path = map.Dijkstra();
+        path == std::numeric_limits<size_t>::max())
+    {
+      result = map.last;
+      break;
+    }
+  }
+
+  return std::to_string(result.column) + ',' + std::to_string(result.row);
+}
+
 TEST_CASE("Check with test data")
 {
   SECTION("Part 1")
@@ -181,7 +149,7 @@ TEST_CASE("Check with test data")
   SECTION("Part 2")
   {
     Point result;
-    Point expected{6, 1};
+    Point expected{1, 6};
     for (size_t i = 1; i < 30; ++i)
     {
       std::stringstream testInput{testData};
@@ -200,33 +168,35 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 18")
 {
-  Timer t;
 
   SECTION("part 1")
   {
     std::ifstream data("data.txt");
     REQUIRE(data.is_open());
     Map map{data, 70, 70, 1024};
-    std::cout << "Day 18 - part 1 result: " << map.Dijkstra() << std::endl;
+    ReportResult(18, 1, [&]
+                        { return map.Dijkstra(); });
   }
 
   SECTION("part 2")
   {
-    Point result;
+    std::ifstream data("data.txt");
+    REQUIRE(data.is_open());
+    ReportResult(18, 2, [&]
+                        { return FindFirstBlockingByte(data, 70, 70); });
+  }
+}
 
-    for (size_t i = 1; i < 3500; ++i)
-    {
-      std::ifstream data("data.txt");
-      REQUIRE(data.is_open());
-      Map map{data, 70, 70, i};
-      if (size_t path = map.Dijkstra();
-          path == std::numeric_limits<size_t>::max())
-      {
-        result = map.last;
-        break;
-      }
-    }
+TEST_CASE("Batch day 18")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return Map{input, 70, 70, 1024}.Dijkstra();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return FindFirstBlockingByte(input, 70, 70);
+  };
 
-    std::cout << "Day 15 - part 2 result: " << result.column << ',' << result.row << std::endl;
-  }
+  RunBatch(18, part1, part2);
 }
\ No newline at end of file
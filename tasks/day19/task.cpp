@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/MemoCache.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <fstream>
 #include <regex>
 #include <unordered_set>
@@ -35,7 +37,7 @@ struct TowelProduction
 {
   using PositionsOfWords = std::vector<std::pair<std::unordered_set<size_t>, std::string>>;
 
-  TowelProduction(std::istream &input)
+  TowelProduction(std::istream &input, size_t cacheCapacity = 0) : wordToCost(cacheCapacity)
   {
     std::string line;
     std::getline(input, line);
@@ -91,10 +93,11 @@ struct TowelProduction
       for (size_t i = 0; i <= design.size(); ++i)
       {
         auto sub = design.substr(design.size() - i);
-        if (!wordToCost.contains(sub))
-          wordToCost[sub] = CountPossibleCombinations(sub);
+        wordToCost.GetOrCompute(sub, [&]
+                                { return CountPossibleCombinations(sub); });
       }
-      count += wordToCost[design];
+      count += wordToCost.GetOrCompute(design, [&]
+                                       { return CountPossibleCombinations(design); });
       // std::cout << design << " current solutions: " << count << std::endl;
     }
 
@@ -150,9 +153,9 @@ struct TowelProduction
       return;
     }
 
-    if (wordToCost.contains(design.substr(currentWord.size())))
+    if (const auto *cost = wordToCost.Find(design.substr(currentWord.size())))
     {
-      numOfSolutions += wordToCost[design.substr(currentWord.size())];
+      numOfSolutions += *cost;
       return;
     }
 
@@ -191,7 +194,7 @@ struct TowelProduction
 
   std::vector<std::string> stripes;
   std::vector<std::string> designs;
-  std::unordered_map<std::string, size_t> wordToCost;
+  MemoCache<std::string, size_t> wordToCost;
 };
 
 TEST_CASE("Find all")
@@ -217,18 +220,34 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 19")
 {
-  Timer t;
   std::ifstream data("data.txt");
   REQUIRE(data.is_open());
   TowelProduction tp{data};
 
   SECTION("part 1")
   {
-    std::cout << "Day 19 - part 1 result: " << tp.CountProducableTowels() << std::endl;
+    ReportResult(19, 1, [&]
+                        { return tp.CountProducableTowels(); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 19 - part 2 result: " << tp.CountPossibleCombinations() << std::endl;
+    ReportResult(19, 2, [&]
+                        { return tp.CountPossibleCombinations(); });
+    ReportCacheStats(19, "wordToCost", tp.wordToCost.GetStats());
   }
+}
+
+TEST_CASE("Batch day 19")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return TowelProduction{input}.CountProducableTowels();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return TowelProduction{input}.CountPossibleCombinations();
+  };
+
+  RunBatch(19, part1, part2);
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <unordered_set>
 #include <queue>
@@ -20,52 +22,8 @@ constexpr auto testDataFirst = R"(###############
 #...#...#...###
 ###############)";
 
-struct Point
-{
-  int column;
-  int row;
-
-  Point operator+(const Point &other) const
-  {
-    return {column + other.column, row + other.row};
-  }
-
-  auto operator<=>(const Point &) const = default;
-
-  Point PointUp() const
-  {
-    return Point{column, row - 1};
-  }
-
-  Point PointDown() const
-  {
-    return Point{column, row + 1};
-  }
-
-  Point PointLeft() const
-  {
-    return Point{column - 1, row};
-  }
-  Point PointRight() const
-  {
-    return Point{column + 1, row};
-  }
-};
-
-namespace std
-{
-  template <>
-  struct hash<Point>
-  {
-    size_t operator()(const Point &p) const
-    {
-      size_t h1 = std::hash<int>{}(p.row);
-      size_t h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-}
+using aoc::Direction;
+using aoc::Point;
 
 struct Map2
 {
@@ -79,7 +37,7 @@ struct Map2
       int column = 0;
       for (const auto &c : line)
       {
-        const auto &p = Point{column, row};
+        const auto &p = Point{row, column};
         if (c == '#')
         {
           wallPoints.emplace(p);
@@ -115,10 +73,10 @@ struct Map2
       }
 
       const std::vector<Point> siblings{
-          currentPoint.PointUp(),
-          currentPoint.PointLeft(),
-          currentPoint.PointRight(),
-          currentPoint.PointDown()};
+          currentPoint.Neighbour(Direction::Up),
+          currentPoint.Neighbour(Direction::Left),
+          currentPoint.Neighbour(Direction::Right),
+          currentPoint.Neighbour(Direction::Down)};
 
       for (const auto &sibling : siblings)
       {
@@ -141,10 +99,10 @@ struct Map2
     for (const auto &[point, cost] : visited)
     {
       const std::vector<Point> siblings{
-          point.PointUp().PointUp(),
-          point.PointLeft().PointLeft(),
-          point.PointRight().PointRight(),
-          point.PointDown().PointDown()};
+          point.Neighbour(Direction::Up).Neighbour(Direction::Up),
+          point.Neighbour(Direction::Left).Neighbour(Direction::Left),
+          point.Neighbour(Direction::Right).Neighbour(Direction::Right),
+          point.Neighbour(Direction::Down).Neighbour(Direction::Down)};
       for (const auto &sibling : siblings)
       {
         if (!visited.contains(sibling))
@@ -200,7 +158,6 @@ TEST_CASE("Check with test data")
 
 TEST_CASE("Task day 20")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -208,14 +165,38 @@ TEST_CASE("Task day 20")
   SECTION("part 1")
   {
     Map2 map{data};
-    map.Dijkstra();
-    std::cout << "Day 20 - part 1 result: " << map.CountShortcutsWithDiff(99) << std::endl;
+    ReportResult(20, 1, [&]
+                        {
+                          map.Dijkstra();
+                          return map.CountShortcutsWithDiff(99);
+                        });
   }
 
   SECTION("part 2")
   {
     Map2 map{data};
-    map.Dijkstra();
-    std::cout << "Day 20 - part 2 result: " << map.CountLongerShortcutsWithDiff(99) << std::endl;
+    ReportResult(20, 2, [&]
+                        {
+                          map.Dijkstra();
+                          return map.CountLongerShortcutsWithDiff(99);
+                        });
   }
+}
+
+TEST_CASE("Batch day 20")
+{
+  auto part1 = [](std::istream &input)
+  {
+    Map2 map{input};
+    map.Dijkstra();
+    return map.CountShortcutsWithDiff(99);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    Map2 map{input};
+    map.Dijkstra();
+    return map.CountLongerShortcutsWithDiff(99);
+  };
+
+  RunBatch(20, part1, part2);
 }
\ No newline at end of file
@@ -1,60 +1,17 @@
 #include <catch2/catch_all.hpp>
-#include <utils/Timer.h>
+#include <utils/MemoCache.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Point.h>
 #include <fstream>
 #include <unordered_set>
 #include <queue>
 
-struct Point
-{
-  int column;
-  int row;
-
-  Point operator+(const Point &other) const
-  {
-    return {column + other.column, row + other.row};
-  }
-
-  Point operator-(const Point &other) const
-  {
-    return {column - other.column, row - other.row};
-  }
-
-  auto operator<=>(const Point &) const = default;
-
-  Point PointUp() const
-  {
-    return Point{column, row - 1};
-  }
-
-  Point PointDown() const
-  {
-    return Point{column, row + 1};
-  }
-
-  Point PointLeft() const
-  {
-    return Point{column - 1, row};
-  }
-  Point PointRight() const
-  {
-    return Point{column + 1, row};
-  }
-};
+using aoc::Direction;
+using aoc::Point;
 
 namespace std
 {
-  template <>
-  struct hash<Point>
-  {
-    size_t operator()(const Point &p) const
-    {
-      size_t h1 = std::hash<int>{}(p.row);
-      size_t h2 = std::hash<int>{}(p.column);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-
   template <>
   struct hash<pair<char, char>>
   {
@@ -89,9 +46,11 @@ struct TupleHash
   }
 };
 
+using SequenceCache = MemoCache<std::tuple<std::string, size_t, size_t>, size_t, TupleHash>;
+
 struct Keyboard
 {
-  std::vector<std::string> GetMovementsFromTo(char from, char to)
+  std::vector<std::string> GetMovementsFromTo(char from, char to) const
   {
     return pointsToMovements.at({from, to});
   }
@@ -131,10 +90,10 @@ struct Keyboard
       }
 
       std::vector<Point> siblings{
-          point.PointUp(),
-          point.PointDown(),
-          point.PointLeft(),
-          point.PointRight()};
+          point.Neighbour(Direction::Up),
+          point.Neighbour(Direction::Down),
+          point.Neighbour(Direction::Left),
+          point.Neighbour(Direction::Right)};
 
       for (const auto &sibling : siblings)
       {
@@ -213,10 +172,10 @@ struct Keyboard
       pointsToMovements;
   std::unordered_map<char, Point> valueToPoint;
   std::unordered_map<Point, std::string> diffToDirection{
-      {{-1, 0}, "<"},
-      {{1, 0}, ">"},
-      {{0, -1}, "^"},
-      {{0, 1}, "v"},
+      {{0, -1}, "<"},
+      {{0, 1}, ">"},
+      {{-1, 0}, "^"},
+      {{1, 0}, "v"},
       {{0, 0}, ""},
   };
   std::unordered_set<Point> keys;
@@ -230,15 +189,15 @@ struct NumericKeyboard : public Keyboard
     keys.emplace(p);
     valueToPoint.emplace('7', p);
 
-    p = Point{1, 0};
+    p = Point{0, 1};
     keys.emplace(p);
     valueToPoint.emplace('8', p);
 
-    p = Point{2, 0};
+    p = Point{0, 2};
     keys.emplace(p);
     valueToPoint.emplace('9', p);
 
-    p = Point{0, 1};
+    p = Point{1, 0};
     keys.emplace(p);
     valueToPoint.emplace('4', p);
 
@@ -246,15 +205,15 @@ struct NumericKeyboard : public Keyboard
     keys.emplace(p);
     valueToPoint.emplace('5', p);
 
-    p = Point{2, 1};
+    p = Point{1, 2};
     keys.emplace(p);
     valueToPoint.emplace('6', p);
 
-    p = Point{0, 2};
+    p = Point{2, 0};
     keys.emplace(p);
     valueToPoint.emplace('1', p);
 
-    p = Point{1, 2};
+    p = Point{2, 1};
     keys.emplace(p);
     valueToPoint.emplace('2', p);
 
@@ -262,11 +221,11 @@ struct NumericKeyboard : public Keyboard
     keys.emplace(p);
     valueToPoint.emplace('3', p);
 
-    p = Point{1, 3};
+    p = Point{3, 1};
     keys.emplace(p);
     valueToPoint.emplace('0', p);
 
-    p = Point{2, 3};
+    p = Point{3, 2};
     keys.emplace(p);
     valueToPoint.emplace('A', p);
 
@@ -278,15 +237,15 @@ struct DirectionKeyboard : public Keyboard
 {
   DirectionKeyboard()
   {
-    Point p{1, 0};
+    Point p{0, 1};
     keys.emplace(p);
     valueToPoint.emplace('^', p);
 
-    p = Point{2, 0};
+    p = Point{0, 2};
     keys.emplace(p);
     valueToPoint.emplace('A', p);
 
-    p = Point{0, 1};
+    p = Point{1, 0};
     keys.emplace(p);
     valueToPoint.emplace('<', p);
 
@@ -294,7 +253,7 @@ struct DirectionKeyboard : public Keyboard
     keys.emplace(p);
     valueToPoint.emplace('v', p);
 
-    p = Point{2, 1};
+    p = Point{1, 2};
     keys.emplace(p);
     valueToPoint.emplace('>', p);
 
@@ -337,7 +296,7 @@ std::unordered_set<std::string> getAllCombinations(const std::vector<std::vector
 
 std::unordered_set<std::string> GetNumericCombinations(const std::string &input)
 {
-  NumericKeyboard numericKeyboard;
+  static const NumericKeyboard numericKeyboard;
 
   char keyboardPosition = 'A';
 
@@ -354,19 +313,19 @@ std::unordered_set<std::string> GetNumericCombinations(const std::string &input)
 
 size_t FindShortestSequence(std::string &sequence,
                             size_t numberOfRobots,
-                            std::unordered_map<std::tuple<std::string, size_t, size_t>, size_t, TupleHash> &cache,
+                            SequenceCache &cache,
                             size_t currentRobotNumber = 0)
 {
-  DirectionKeyboard keyboard;
+  static const DirectionKeyboard keyboard;
 
   if (numberOfRobots == currentRobotNumber)
   {
     return sequence.size();
   }
 
-  if (cache.contains({sequence, numberOfRobots, currentRobotNumber}))
+  if (const auto *cached = cache.Find({sequence, numberOfRobots, currentRobotNumber}))
   {
-    return cache.at({sequence, numberOfRobots, currentRobotNumber});
+    return *cached;
   }
 
   char currentPosition = 'A';
@@ -385,14 +344,6 @@ size_t FindShortestSequence(std::string &sequence,
     }
   }
 
-  // std::cout << std::format("command: {}, commandSplits: ",
-  //                          sequence);
-  // for (const auto &c : arrowSequences)
-  // {
-  //   std::cout << c << ",";
-  // }
-  // std::cout << std::endl;
-
   size_t shortest = 0;
   for (auto &arrowSequence : arrowSequences)
   {
@@ -406,15 +357,20 @@ size_t FindShortestSequence(std::string &sequence,
     shortest += local;
   }
 
-  std::cout << std::format("command: {}, numRobots: {}, keypad: {}, result: {}\n",
-                           sequence, numberOfRobots, currentRobotNumber, shortest);
-  cache[{sequence, numberOfRobots, currentRobotNumber}] = shortest;
+  cache.Insert({sequence, numberOfRobots, currentRobotNumber}, shortest);
   return shortest;
 }
 
+// Shared by every code solved on a thread, batch workers each get their own.
+SequenceCache &GetSequenceCache()
+{
+  thread_local SequenceCache cache;
+  return cache;
+}
+
 size_t GetCodeComplexity(const std::string &input, size_t numberOfRobots = 2)
 {
-  static std::unordered_map<std::tuple<std::string, size_t, size_t>, size_t, TupleHash> cache;
+  auto &cache = GetSequenceCache();
 
   const auto &numericMovements = GetNumericCombinations(input);
 
@@ -430,9 +386,6 @@ size_t GetCodeComplexity(const std::string &input, size_t numberOfRobots = 2)
   for (auto &numericSequence : tmp)
   {
     size_t temp = FindShortestSequence(numericSequence, numberOfRobots, cache);
-    std::cout << std::format("command: {}, commandSplits: {}",
-                             numericSequence, temp)
-              << std::endl;
     if (temp < length)
       length = temp;
   }
@@ -482,22 +435,26 @@ TEST_CASE("Check nested combination")
   CHECK(64 * 379 == GetCodeComplexity("379A"));
 }
 
-TEST_CASE("Task day 20")
+TEST_CASE("Task day 21")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("part 1")
   {
-    std::cout << "Day 21 - part 1 result: " << SumComplexity(data, 25) << std::endl;
+    ReportResult(21, 1, [&]
+                        { return SumComplexity(data, 25); });
+    ReportCacheStats(21, "sequences", GetSequenceCache().GetStats());
   }
+}
+
+TEST_CASE("Batch day 21")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return SumComplexity(input, 25);
+  };
 
-  //   // SECTION("part 2")
-  //   // {
-  //   //   Map2 map{data};
-  //   //   map.Dijkstra();
-  //   //   std::cout << "Day 20 - part 2 result: " << map.CountLongerShortcutsWithDiff(99) << std::endl;
-  //   // }
+  RunBatch(21, part1);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 #include <queue>
 #include <numeric>
 
@@ -159,18 +160,33 @@ TEST_CASE("Part 2")
 
 TEST_CASE("Task day 22")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("part 1")
   {
-    std::cout << "Day 22 - part 1 result: " << Sum2000thSecretNumbers(data) << std::endl;
+    ReportResult(22, 1, [&]
+                        { return Sum2000thSecretNumbers(data); });
   }
 
   SECTION("part 2")
   {
-    std::cout << "Day 22 - part 2 result: " << CountBananas(data) << std::endl;
+    ReportResult(22, 2, [&]
+                        { return CountBananas(data); });
   }
+}
+
+TEST_CASE("Batch day 22")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return Sum2000thSecretNumbers(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return CountBananas(input);
+  };
+
+  RunBatch(22, part1, part2);
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include <catch2/catch_all.hpp>
 #include <unordered_set>
 #include <fstream>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 
 constexpr auto testData = R"(kh-tc
 qp-kh
@@ -188,6 +189,24 @@ std::unordered_set<std::string> findMaximumClique(const Graph &graph)
   return maxClique;
 }
 
+std::string GetLanPartyPassword(std::istream &input)
+{
+  Graph g{input};
+  const auto &maxClique = findMaximumClique(g);
+  std::vector<std::string> solution{maxClique.begin(), maxClique.end()};
+  std::ranges::sort(solution);
+  std::string password;
+  for (const auto &node : solution)
+  {
+    if (!password.empty())
+    {
+      password += ',';
+    }
+    password += node;
+  }
+  return password;
+}
+
 TEST_CASE("Check with test data - part 1")
 {
   std::stringstream testInput{testData};
@@ -205,31 +224,33 @@ TEST_CASE("Check with test data - part 2")
 
 TEST_CASE("Task day 23")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("Day 23 - part 1")
   {
-    std::cout << "Day 23 - part 1 result: " << CountSetsWithT(data) << std::endl;
+    ReportResult(23, 1, [&]
+                        { return CountSetsWithT(data); });
   }
 
   SECTION("Day 23 - part 1")
   {
-    Graph g{data};
-    const auto &maxClique = findMaximumClique(g);
-    std::vector<std::string> solution{maxClique.begin(), maxClique.end()};
-    std::ranges::sort(solution);
-    std::string password;
-    for (const auto &node : solution)
-    {
-      if (!password.empty())
-      {
-        password += ',';
-      }
-      password += node;
-    }
-    std::cout << "Day 23 - part 2 result: " << password << std::endl;
+    ReportResult(23, 2, [&]
+                        { return GetLanPartyPassword(data); });
   }
+}
+
+TEST_CASE("Batch day 23")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return CountSetsWithT(input);
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return GetLanPartyPassword(input);
+  };
+
+  RunBatch(23, part1, part2);
 }
\ No newline at end of file
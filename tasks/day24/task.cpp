@@ -1,7 +1,8 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
 #include <numeric>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
 
 constexpr auto testData = R"(x00: 1
 x01: 0
@@ -232,18 +233,33 @@ TEST_CASE("Check with test data - part 1")
 
 TEST_CASE("Task day 24")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
 
   SECTION("Day 24 - part 1")
   {
-    std::cout << "Day 24 - part 1 result: " << WireSet(data).GetOutputZ() << std::endl;
+    ReportResult(24, 1, [&]
+                        { return WireSet(data).GetOutputZ(); });
   }
 
   SECTION("Day 24 - part 2")
   {
-    std::cout << "Day 24 - part 2 result: " << WireSet(data).GetWrongOutputs() << std::endl;
+    ReportResult(24, 2, [&]
+                        { return WireSet(data).GetWrongOutputs(); });
   }
+}
+
+TEST_CASE("Batch day 24")
+{
+  auto part1 = [](std::istream &input)
+  {
+    return WireSet(input).GetOutputZ();
+  };
+  auto part2 = [](std::istream &input)
+  {
+    return WireSet(input).GetWrongOutputs();
+  };
+
+  RunBatch(24, part1, part2);
 }
\ No newline at end of file
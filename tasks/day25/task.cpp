@@ -1,7 +1,9 @@
 #include <catch2/catch_all.hpp>
 #include <fstream>
 #include <ranges>
-#include <utils/Timer.h>
+#include <utils/Results.h>
+#include <utils/Batch.h>
+#include <utils/Records.h>
 
 constexpr auto testData = R"(#####
 .####
@@ -45,36 +47,39 @@ constexpr auto testData = R"(#####
 
 using Schema = std::vector<std::vector<int>>;
 
-std::pair<Schema, Schema> ReadKeysAndLocks(std::istream &input)
+std::vector<int> ReadHeights(std::string_view block)
 {
-  Schema locks;
-  Schema keys;
+  std::vector<int> elems(5, 0);
 
-  std::string line;
-
-  while (input.good())
+  for (const auto line : Lines(block))
   {
-    std::vector<int> elems(5, 0);
-    std::string lastLine;
-
-    while (std::getline(input, line) && !line.empty())
+    for (size_t i = 0; i < line.size(); ++i)
     {
-      lastLine = line;
-      for (size_t i = 0; i < line.size(); ++i)
+      if (line[i] == '#')
       {
-        if (line[i] == '#')
-        {
-          ++elems[i];
-        }
+        ++elems[i];
       }
     }
-    if (lastLine == "#####")
+  }
+  return elems;
+}
+
+std::pair<Schema, Schema> ReadKeysAndLocks(std::istream &input)
+{
+  Schema locks;
+  Schema keys;
+
+  const auto buffer = ReadBuffer(input);
+
+  for (const auto block : Blocks(buffer))
+  {
+    if (block.substr(block.rfind('\n') + 1) == "#####")
     {
-      keys.push_back(elems);
+      keys.push_back(ReadHeights(block));
     }
     else
     {
-      locks.push_back(elems);
+      locks.push_back(ReadHeights(block));
     }
   }
   return {keys, locks};
@@ -119,7 +124,6 @@ TEST_CASE("Check with test data - part 1")
 
 TEST_CASE("Task day 25")
 {
-  Timer t;
   std::ifstream data("data.txt");
 
   REQUIRE(data.is_open());
@@ -127,6 +131,18 @@ TEST_CASE("Task day 25")
 
   SECTION("Day 25 - part 1")
   {
-    std::cout << "Day 25 - part 1 result: " << CountFittingConfigurations(keys, locks) << std::endl;
+    ReportResult(25, 1, [&]
+                        { return CountFittingConfigurations(keys, locks); });
   }
+}
+
+TEST_CASE("Batch day 25")
+{
+  auto part1 = [](std::istream &input)
+  {
+    const auto &[keys, locks] = ReadKeysAndLocks(input);
+    return CountFittingConfigurations(keys, locks);
+  };
+
+  RunBatch(25, part1);
 }
\ No newline at end of file
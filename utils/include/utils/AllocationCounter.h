@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+struct AllocationStats
+{
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+
+  AllocationStats operator-(const AllocationStats &other) const
+  {
+    return {count - other.count, bytes - other.bytes};
+  }
+};
+
+// Totals of every global operator new call made by the process so far.
+AllocationStats GetAllocationStats();
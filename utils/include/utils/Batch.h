@@ -0,0 +1,178 @@
+#pragma once
+
+#include <utils/Parallel.h>
+#include <utils/Results.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Batch mode is enabled by AOC_BATCH_INPUTS, pointing either at a directory whose
+// regular files are all inputs, or at a text file listing one input path per line.
+// AOC_BATCH_THREADS limits the number of workers, by default all cores are used.
+inline std::vector<std::filesystem::path> GetBatchInputs()
+{
+  std::vector<std::filesystem::path> inputs;
+
+  const char *source = std::getenv("AOC_BATCH_INPUTS");
+  if (source == nullptr)
+  {
+    return inputs;
+  }
+
+  if (std::filesystem::is_directory(source))
+  {
+    for (const auto &entry : std::filesystem::directory_iterator(source))
+    {
+      if (entry.is_regular_file())
+      {
+        inputs.push_back(entry.path());
+      }
+    }
+    std::ranges::sort(inputs);
+  }
+  else
+  {
+    std::ifstream list(source);
+    std::string line;
+    while (std::getline(list, line))
+    {
+      if (!line.empty())
+      {
+        inputs.emplace_back(line);
+      }
+    }
+  }
+  return inputs;
+}
+
+inline size_t GetBatchThreads(size_t inputsCount)
+{
+  size_t threads = GetWorkersCount();
+  if (const char *limit = std::getenv("AOC_BATCH_THREADS"))
+  {
+    threads = std::max(1, std::atoi(limit));
+  }
+  return std::min(threads, std::max<size_t>(inputsCount, 1));
+}
+
+// Every part gets its own stream over the input, like the sections of the day tests.
+template <typename... Parts>
+std::string SolveBatchInput(int day, const std::filesystem::path &path, Parts &...parts)
+{
+  const auto format = GetResultFormat();
+  std::ostringstream answers;
+  std::string error;
+  bool first = true;
+
+  auto solvePart = [&](auto &part)
+  {
+    std::ifstream input(path);
+    if (!input.is_open())
+    {
+      throw std::runtime_error("cannot open input");
+    }
+
+    const auto answer = part(input);
+    if (!first)
+    {
+      answers << (format == ResultFormat::Json ? "," : ", ");
+    }
+    first = false;
+
+    if (format == ResultFormat::Json)
+    {
+      WriteJsonValue(answers, answer);
+    }
+    else
+    {
+      answers << answer;
+    }
+  };
+
+  const auto startTime = std::chrono::high_resolution_clock::now();
+  try
+  {
+    (solvePart(parts), ...);
+  }
+  catch (const std::exception &e)
+  {
+    error = e.what();
+  }
+  catch (...)
+  {
+    error = "unknown error";
+  }
+  const auto endTime = std::chrono::high_resolution_clock::now();
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+  std::ostringstream row;
+  if (format == ResultFormat::Text)
+  {
+    row << "Day " << day << " - " << path.string() << ": " << answers.str();
+    if (!error.empty())
+    {
+      row << (first ? "" : ", ") << "error: " << error;
+    }
+    return row.str();
+  }
+
+  row << "{\"day\":" << day
+      << ",\"input\":\"" << EscapeJson(path.string()) << '"'
+      << ",\"answers\":[" << answers.str() << ']';
+  if (!error.empty())
+  {
+    row << ",\"error\":\"" << EscapeJson(error) << '"';
+  }
+  row << ",\"time_us\":" << duration
+      << ",\"input_hash\":\"" << std::hex << HashInput(path.string()) << std::dec << "\"}";
+  return row.str();
+}
+
+// Solves every batch input in one process, spreading inputs across worker threads,
+// and prints one row per input in input order. Does nothing outside batch mode.
+template <typename... Parts>
+void RunBatch(int day, Parts... parts)
+{
+  const auto inputs = GetBatchInputs();
+  if (inputs.empty())
+  {
+    return;
+  }
+
+  std::vector<std::string> rows(inputs.size());
+  std::atomic<size_t> next{0};
+
+  // Inputs vary a lot in size, so workers take the next unsolved one instead of a
+  // fixed chunk.
+  auto worker = [&]
+  {
+    for (size_t i = next++; i < inputs.size(); i = next++)
+    {
+      rows[i] = SolveBatchInput(day, inputs[i], parts...);
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < GetBatchThreads(inputs.size()); ++i)
+    {
+      workers.emplace_back(worker);
+    }
+    worker();
+  }
+
+  for (const auto &row : rows)
+  {
+    WriteResultLine(row);
+  }
+}
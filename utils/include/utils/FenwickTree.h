@@ -0,0 +1,67 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary indexed tree over [0, size) with point updates and prefix sums in O(log n).
+template <typename T>
+class FenwickTree
+{
+public:
+  explicit FenwickTree(size_t size_) : tree(size_ + 1, T{}) {}
+
+  size_t Size() const
+  {
+    return tree.size() - 1;
+  }
+
+  void Add(size_t index, T delta)
+  {
+    for (++index; index < tree.size(); index += index & (~index + 1))
+    {
+      tree[index] += delta;
+    }
+  }
+
+  // Sum of the elements [0, index].
+  T PrefixSum(size_t index) const
+  {
+    T sum{};
+    for (++index; index > 0; index -= index & (~index + 1))
+    {
+      sum += tree[index];
+    }
+    return sum;
+  }
+
+  T RangeSum(size_t first, size_t last) const
+  {
+    return first == 0 ? PrefixSum(last) : PrefixSum(last) - PrefixSum(first - 1);
+  }
+
+  T At(size_t index) const
+  {
+    return RangeSum(index, index);
+  }
+
+  // Smallest index whose prefix sum exceeds target, or Size() when there is none.
+  // Requires non-negative elements.
+  size_t UpperBound(T target) const
+  {
+    size_t position = 0;
+    for (size_t step = std::bit_floor(Size()); step > 0; step >>= 1)
+    {
+      if (position + step < tree.size() && tree[position + step] <= target)
+      {
+        position += step;
+        target -= tree[position];
+      }
+    }
+    return position;
+  }
+
+private:
+  std::vector<T> tree;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+// Minimal lazy generator in the spirit of C++23 std::generator, which is not yet
+// shipped by every standard library we build with.
+template <typename T>
+class Generator
+{
+public:
+  struct promise_type
+  {
+    Generator get_return_object()
+    {
+      return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    std::suspend_always yield_value(T val)
+    {
+      value.emplace(std::move(val));
+      return {};
+    }
+
+    void return_void() {}
+
+    void unhandled_exception()
+    {
+      exception = std::current_exception();
+    }
+
+    std::optional<T> value;
+    std::exception_ptr exception;
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  class Iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+
+    Iterator() = default;
+    explicit Iterator(Handle handle_) : handle(handle_) {}
+
+    T &operator*() const
+    {
+      return *handle.promise().value;
+    }
+
+    Iterator &operator++()
+    {
+      Resume(handle);
+      return *this;
+    }
+
+    void operator++(int)
+    {
+      ++*this;
+    }
+
+    bool operator==(std::default_sentinel_t) const
+    {
+      return !handle || handle.done();
+    }
+
+  private:
+    Handle handle;
+  };
+
+  explicit Generator(Handle handle_) : handle(handle_) {}
+
+  Generator(Generator &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+  Generator &operator=(Generator &&other) noexcept
+  {
+    if (this != &other)
+    {
+      if (handle)
+      {
+        handle.destroy();
+      }
+      handle = std::exchange(other.handle, {});
+    }
+    return *this;
+  }
+
+  Generator(const Generator &) = delete;
+  Generator &operator=(const Generator &) = delete;
+
+  ~Generator()
+  {
+    if (handle)
+    {
+      handle.destroy();
+    }
+  }
+
+  Iterator begin()
+  {
+    Resume(handle);
+    return Iterator{handle};
+  }
+
+  std::default_sentinel_t end() const
+  {
+    return {};
+  }
+
+private:
+  static void Resume(Handle handle)
+  {
+    handle.promise().value.reset();
+    handle.resume();
+    if (handle.promise().exception)
+    {
+      std::rethrow_exception(handle.promise().exception);
+    }
+  }
+
+  Handle handle;
+};
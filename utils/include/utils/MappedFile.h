@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+// Read-only view of a whole input file, memory mapped where the platform allows it.
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string &path)
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+      ::close(fd);
+      throw std::runtime_error("Cannot stat " + path);
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0)
+    {
+      void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)
+      {
+        ::close(fd);
+        throw std::runtime_error("Cannot map " + path);
+      }
+      data = static_cast<const char *>(mapping);
+    }
+    ::close(fd);
+#else
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open())
+    {
+      throw std::runtime_error("Cannot open " + path);
+    }
+    content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    data = content.data();
+    size = content.size();
+#endif
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile()
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    if (data != nullptr)
+    {
+      ::munmap(const_cast<char *>(data), size);
+    }
+#endif
+  }
+
+  std::string_view View() const
+  {
+    return {data, size};
+  }
+
+private:
+  const char *data = nullptr;
+  size_t size = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+  std::string content;
+#endif
+};
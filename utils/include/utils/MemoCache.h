@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct CacheStats
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t size = 0;
+};
+
+inline std::ostream &operator<<(std::ostream &output, const CacheStats &stats)
+{
+  return output << "hits: " << stats.hits
+                << ", misses: " << stats.misses
+                << ", evictions: " << stats.evictions
+                << ", size: " << stats.size;
+}
+
+// Memoisation cache for recursive solvers. With a non-zero capacity entries are
+// evicted with the CLOCK policy: every hit marks an entry as referenced and the
+// clock hand gives referenced entries a second chance before replacing them.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class MemoCache
+{
+public:
+  explicit MemoCache(size_t capacity_ = 0) : capacity(capacity_)
+  {
+    if (capacity != 0)
+    {
+      entries.reserve(capacity);
+      index.reserve(capacity);
+    }
+  }
+
+  // The returned value is only valid until the next insertion.
+  const Value *Find(const Key &key)
+  {
+    const auto it = index.find(key);
+    if (it == index.end())
+    {
+      ++stats.misses;
+      return nullptr;
+    }
+
+    ++stats.hits;
+    auto &entry = entries[it->second];
+    entry.referenced = true;
+    return &entry.value;
+  }
+
+  void Insert(const Key &key, Value value)
+  {
+    if (const auto it = index.find(key); it != index.end())
+    {
+      entries[it->second].value = std::move(value);
+      return;
+    }
+
+    if (capacity == 0 || entries.size() < capacity)
+    {
+      index.emplace(key, entries.size());
+      entries.push_back(Entry{key, std::move(value), false});
+      return;
+    }
+
+    const size_t slot = FindVictim();
+    index.erase(entries[slot].key);
+    ++stats.evictions;
+
+    entries[slot] = Entry{key, std::move(value), false};
+    index.emplace(key, slot);
+  }
+
+  template <typename Compute>
+  Value GetOrCompute(const Key &key, Compute compute)
+  {
+    if (const auto *value = Find(key))
+    {
+      return *value;
+    }
+
+    Value value = compute();
+    Insert(key, value);
+    return value;
+  }
+
+  size_t Size() const
+  {
+    return entries.size();
+  }
+
+  CacheStats GetStats() const
+  {
+    auto result = stats;
+    result.size = entries.size();
+    return result;
+  }
+
+private:
+  struct Entry
+  {
+    Key key;
+    Value value;
+    bool referenced;
+  };
+
+  size_t FindVictim()
+  {
+    while (entries[hand].referenced)
+    {
+      entries[hand].referenced = false;
+      hand = (hand + 1) % entries.size();
+    }
+
+    const size_t victim = hand;
+    hand = (hand + 1) % entries.size();
+    return victim;
+  }
+
+  size_t capacity;
+  size_t hand = 0;
+  std::vector<Entry> entries;
+  std::unordered_map<Key, size_t, Hash, KeyEqual> index;
+  CacheStats stats;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+inline size_t GetWorkersCount()
+{
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Splits [0, count) into workersCount contiguous chunks and calls fn(begin, end) for
+// every chunk on its own thread, the calling thread taking the first one. Returns the
+// results of the chunks in order, once all of them are done.
+template <typename Fn>
+auto ParallelChunks(size_t count, size_t workersCount, Fn fn)
+{
+  using Result = std::invoke_result_t<Fn &, size_t, size_t>;
+
+  workersCount = std::max<size_t>(workersCount, 1);
+  auto bound = [=](size_t chunk)
+  {
+    return count * chunk / workersCount;
+  };
+
+  if constexpr (std::is_void_v<Result>)
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < workersCount; ++i)
+    {
+      workers.emplace_back([&, i]
+                           { fn(bound(i), bound(i + 1)); });
+    }
+    fn(bound(0), bound(1));
+  }
+  else
+  {
+    std::vector<Result> results(workersCount);
+    {
+      std::vector<std::jthread> workers;
+      for (size_t i = 1; i < workersCount; ++i)
+      {
+        workers.emplace_back([&, i]
+                             { results[i] = fn(bound(i), bound(i + 1)); });
+      }
+      results[0] = fn(bound(0), bound(1));
+    }
+    return results;
+  }
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// String literal usable as a template argument.
+template <size_t N>
+struct FixedPattern
+{
+  constexpr FixedPattern(const char (&text_)[N])
+  {
+    std::copy_n(text_, N, text);
+  }
+
+  constexpr std::string_view View() const
+  {
+    return {text, N - 1};
+  }
+
+  char text[N]{};
+};
+
+// Scanner tables compiled from token patterns. A pattern is matched literally, except
+// '#' which stands for a run of one to maxDigits decimal digits captured as an
+// operand. Every digit of a run has its own state, so a longer run falls back to
+// the initial state and operands cannot overflow.
+// Bytes that do not continue a token restart matching from the initial state. That
+// is exact because the compiler rejects grammars where a first byte of a pattern
+// occurs later in a pattern, or where one pattern is a prefix of another. The same
+// rule lets a scan start at any offset. Line breaks inside a token are skipped, so
+// tokens wrapped over lines are still recognised.
+template <FixedPattern... patterns>
+class Grammar
+{
+public:
+  using State = uint8_t;
+
+  static constexpr size_t patternsCount = sizeof...(patterns);
+  static constexpr size_t maxDigits = 3;
+  static constexpr size_t maxStates = 1 + ((patterns.View().size() + (maxDigits - 1) * static_cast<size_t>(std::ranges::count(patterns.View(), '#'))) + ...);
+  static constexpr State initial = 0;
+  static constexpr uint8_t none = 0xff;
+
+  static_assert(patternsCount > 0 && patternsCount < none);
+  static_assert(maxStates <= 256);
+
+  static constexpr size_t OperandsCount(size_t pattern)
+  {
+    constexpr std::array<std::string_view, patternsCount> views{patterns.View()...};
+    return std::ranges::count(views[pattern], '#');
+  }
+
+  static constexpr size_t maxOperands = std::max({size_t{0}, static_cast<size_t>(std::ranges::count(patterns.View(), '#'))...});
+
+  struct Tables
+  {
+    std::array<std::array<State, 256>, maxStates> transitions{};
+    // Pattern completed on entering a state, or none.
+    std::array<uint8_t, maxStates> accepted{};
+    // Operand a digit run state accumulates into, or none.
+    std::array<uint8_t, maxStates> operand{};
+    std::array<bool, 256> isStartByte{};
+  };
+
+  static constexpr Tables tables = []
+  {
+    constexpr std::array<std::string_view, patternsCount> views{patterns.View()...};
+
+    Tables result;
+    result.accepted.fill(none);
+    result.operand.fill(none);
+    size_t statesCount = 1;
+
+    for (const auto view : views)
+    {
+      if (view.empty() || view.front() == '#')
+      {
+        throw std::logic_error("A pattern must start with a literal byte");
+      }
+      result.isStartByte[static_cast<unsigned char>(view.front())] = true;
+    }
+
+    for (size_t pattern = 0; pattern < patternsCount; ++pattern)
+    {
+      // States the pattern can be in so far, more than one after a digit run.
+      std::array<State, maxDigits> states{initial};
+      size_t statesInUse = 1;
+      uint8_t operand = 0;
+
+      for (size_t i = 0; i < views[pattern].size(); ++i)
+      {
+        const char c = views[pattern][i];
+        const State state = states[0];
+        if (c >= '0' && c <= '9')
+        {
+          throw std::logic_error("Literal digits are not supported, use '#'");
+        }
+        if (i > 0 && result.isStartByte[static_cast<unsigned char>(c)])
+        {
+          throw std::logic_error("A first byte of a pattern occurs inside a pattern");
+        }
+        if (result.accepted[state] != none)
+        {
+          throw std::logic_error("A pattern is a prefix of another");
+        }
+        if (c == '#' && result.operand[state] != none)
+        {
+          throw std::logic_error("Consecutive digit runs are ambiguous");
+        }
+
+        const auto byte = static_cast<unsigned char>(c == '#' ? '0' : c);
+        State next = result.transitions[state][byte];
+        if (next == initial)
+        {
+          next = static_cast<State>(statesCount);
+          statesCount += c == '#' ? maxDigits : 1;
+          for (size_t j = 0; j < statesInUse; ++j)
+          {
+            result.transitions[states[j]][byte] = next;
+          }
+          if (c == '#')
+          {
+            // The digit states form a chain, a digit past the last one has no
+            // transition.
+            for (unsigned char digit = '0'; digit <= '9'; ++digit)
+            {
+              for (size_t j = 0; j < statesInUse; ++j)
+              {
+                result.transitions[states[j]][digit] = next;
+              }
+              for (size_t digits = 1; digits < maxDigits; ++digits)
+              {
+                result.transitions[next + digits - 1][digit] = static_cast<State>(next + digits);
+              }
+            }
+            std::fill_n(result.operand.begin() + next, maxDigits, operand);
+          }
+        }
+
+        statesInUse = c == '#' ? maxDigits : 1;
+        for (size_t j = 0; j < statesInUse; ++j)
+        {
+          states[j] = static_cast<State>(next + j);
+        }
+        operand += c == '#';
+      }
+
+      for (size_t j = 0; j < statesInUse; ++j)
+      {
+        if (result.accepted[states[j]] != none ||
+            std::ranges::any_of(result.transitions[states[j]], [&](State next)
+                                { return next != initial; }))
+        {
+          throw std::logic_error("A pattern is a prefix of another");
+        }
+        result.accepted[states[j]] = static_cast<uint8_t>(pattern);
+      }
+    }
+
+    for (size_t state = 1; state < statesCount; ++state)
+    {
+      for (size_t byte = 0; byte < 256; ++byte)
+      {
+        if (result.isStartByte[byte])
+        {
+          result.transitions[state][byte] = result.transitions[initial][byte];
+        }
+      }
+
+      if (result.accepted[state] == none)
+      {
+        result.transitions[state]['\n'] = static_cast<State>(state);
+        result.transitions[state]['\r'] = static_cast<State>(state);
+      }
+    }
+    return result;
+  }();
+
+  static constexpr auto startBytes = []
+  {
+    std::array<char, std::ranges::count(tables.isStartByte, true)> result{};
+    size_t count = 0;
+    for (size_t byte = 0; byte < 256; ++byte)
+    {
+      if (tables.isStartByte[byte])
+      {
+        result[count++] = static_cast<char>(byte);
+      }
+    }
+    return result;
+  }();
+};
+
+// Position of the next byte that can start a token, or text.size(). Bytes are
+// compared 32 at a time with AVX2, otherwise 8 at a time within a word.
+template <size_t N>
+size_t FindTokenStart(std::string_view text, size_t position, const std::array<char, N> &startBytes)
+{
+#if defined(__AVX2__)
+  for (; position + 32 <= text.size(); position += 32)
+  {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text.data() + position));
+    __m256i candidates = _mm256_setzero_si256();
+    for (const char start : startBytes)
+    {
+      candidates = _mm256_or_si256(candidates, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(start)));
+    }
+    if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(candidates)); mask != 0)
+    {
+      return position + std::countr_zero(mask);
+    }
+  }
+#endif
+  constexpr uint64_t ones = 0x0101010101010101ull;
+  constexpr uint64_t highBits = 0x8080808080808080ull;
+  // Flags zero bytes, false positives only ever follow a real zero byte.
+  auto zeroBytes = [](uint64_t word)
+  {
+    return (word - ones) & ~word & highBits;
+  };
+
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    for (; position + 8 <= text.size(); position += 8)
+    {
+      uint64_t word;
+      std::memcpy(&word, text.data() + position, sizeof(word));
+
+      uint64_t mask = 0;
+      for (const char start : startBytes)
+      {
+        mask |= zeroBytes(word ^ (static_cast<unsigned char>(start) * ones));
+      }
+      if (mask != 0)
+      {
+        return position + std::countr_zero(mask) / 8;
+      }
+    }
+  }
+
+  while (position < text.size() && std::ranges::find(startBytes, text[position]) == startBytes.end())
+  {
+    ++position;
+  }
+  return position;
+}
+
+// Runs text through a compiled grammar and calls the handler of every completed
+// token with its operands. Handlers are given in the order of the grammar patterns.
+// The scanner keeps its state between Scan calls.
+template <typename TokenGrammar, typename... Handlers>
+class PatternScanner
+{
+public:
+  static_assert(sizeof...(Handlers) == TokenGrammar::patternsCount);
+
+  explicit PatternScanner(Handlers... handlers_) : handlers(std::move(handlers_)...) {}
+
+  // Outside a token only start bytes leave the initial state, so the exact matcher
+  // only runs from the candidates the prefilter finds.
+  void Scan(std::string_view text)
+  {
+    size_t position = 0;
+    while (position < text.size())
+    {
+      if (!IsInsideToken())
+      {
+        state = TokenGrammar::initial;
+        position = FindTokenStart(text, position, TokenGrammar::startBytes);
+        if (position == text.size())
+        {
+          return;
+        }
+      }
+      Step(text[position++]);
+    }
+  }
+
+  // Completes the token in progress, if any, without starting a new one.
+  void FinishToken(std::string_view rest)
+  {
+    for (const char c : rest)
+    {
+      if (!IsInsideToken() || tables.isStartByte[static_cast<unsigned char>(c)])
+      {
+        return;
+      }
+      Step(c);
+    }
+  }
+
+  bool IsInsideToken() const
+  {
+    return state != TokenGrammar::initial && tables.accepted[state] == TokenGrammar::none;
+  }
+
+private:
+  static constexpr const auto &tables = TokenGrammar::tables;
+
+  void Step(char c)
+  {
+    const auto next = tables.transitions[state][static_cast<unsigned char>(c)];
+
+    if (const auto operand = tables.operand[next]; operand != TokenGrammar::none)
+    {
+      if (c >= '0' && c <= '9')
+      {
+        operands[operand] = (tables.operand[state] == operand ? operands[operand] * 10 : 0) + (c - '0');
+      }
+    }
+    else if (const auto pattern = tables.accepted[next]; pattern != TokenGrammar::none)
+    {
+      Dispatch(pattern, std::index_sequence_for<Handlers...>{});
+    }
+    state = next;
+  }
+
+  template <size_t... Patterns>
+  void Dispatch(size_t pattern, std::index_sequence<Patterns...>)
+  {
+    ((pattern == Patterns ? Invoke<Patterns>(std::make_index_sequence<TokenGrammar::OperandsCount(Patterns)>{}) : void()), ...);
+  }
+
+  template <size_t Pattern, size_t... Operands>
+  void Invoke(std::index_sequence<Operands...>)
+  {
+    std::get<Pattern>(handlers)(operands[Operands]...);
+  }
+
+  std::tuple<Handlers...> handlers;
+  typename TokenGrammar::State state = TokenGrammar::initial;
+  std::array<int64_t, TokenGrammar::maxOperands> operands{};
+};
+
+template <typename TokenGrammar, typename... Handlers>
+PatternScanner<TokenGrammar, Handlers...> MakePatternScanner(Handlers... handlers)
+{
+  return PatternScanner<TokenGrammar, Handlers...>(std::move(handlers)...);
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Grid geometry shared by the days. Points are always {row, column}, the days pull
+// the names they use in with using declarations.
+namespace aoc
+{
+  // Directions in clockwise order, rows grow downwards.
+  enum class Direction : uint8_t
+  {
+    Up,
+    UpRight,
+    Right,
+    DownRight,
+    Down,
+    DownLeft,
+    Left,
+    UpLeft
+  };
+
+  struct Point
+  {
+    int row;
+    int column;
+
+    constexpr Point operator+(const Point &other) const
+    {
+      return {row + other.row, column + other.column};
+    }
+
+    constexpr Point operator-(const Point &other) const
+    {
+      return {row - other.row, column - other.column};
+    }
+
+    constexpr auto operator<=>(const Point &) const = default;
+
+    constexpr Point Neighbour(Direction direction) const;
+  };
+
+  inline constexpr std::array<Point, 8> directionOffsets{{
+      {-1, 0},
+      {-1, 1},
+      {0, 1},
+      {1, 1},
+      {1, 0},
+      {1, -1},
+      {0, -1},
+      {-1, -1},
+  }};
+
+  inline constexpr std::array<Direction, 4> straightDirections{
+      Direction::Up, Direction::Right, Direction::Down, Direction::Left};
+
+  inline constexpr std::array<Direction, 8> allDirections{
+      Direction::Up, Direction::UpRight, Direction::Right, Direction::DownRight,
+      Direction::Down, Direction::DownLeft, Direction::Left, Direction::UpLeft};
+
+  constexpr Point Point::Neighbour(Direction direction) const
+  {
+    return *this + directionOffsets[static_cast<size_t>(direction)];
+  }
+
+  constexpr Direction TurnRight(Direction direction)
+  {
+    return static_cast<Direction>((static_cast<uint8_t>(direction) + 2) % 8);
+  }
+
+  constexpr Direction TurnLeft(Direction direction)
+  {
+    return static_cast<Direction>((static_cast<uint8_t>(direction) + 6) % 8);
+  }
+
+  constexpr bool IsInside(const Point &p, int rows, int columns)
+  {
+    return p.row >= 0 && p.column >= 0 && p.row < rows && p.column < columns;
+  }
+
+  constexpr size_t ToRowMajorIndex(const Point &p, int columns)
+  {
+    return static_cast<size_t>(p.row) * static_cast<size_t>(columns) + static_cast<size_t>(p.column);
+  }
+
+  constexpr Point FromRowMajorIndex(size_t index, int columns)
+  {
+    return {static_cast<int>(index / columns), static_cast<int>(index % columns)};
+  }
+
+  // Spreads the lower 32 bits so that they occupy the even bit positions.
+  constexpr uint64_t SpreadBits(uint64_t value)
+  {
+    value &= 0xffffffffull;
+    value = (value | (value << 16)) & 0x0000ffff0000ffffull;
+    value = (value | (value << 8)) & 0x00ff00ff00ff00ffull;
+    value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0full;
+    value = (value | (value << 2)) & 0x3333333333333333ull;
+    value = (value | (value << 1)) & 0x5555555555555555ull;
+    return value;
+  }
+
+  constexpr uint64_t CompactBits(uint64_t value)
+  {
+    value &= 0x5555555555555555ull;
+    value = (value | (value >> 1)) & 0x3333333333333333ull;
+    value = (value | (value >> 2)) & 0x0f0f0f0f0f0f0f0full;
+    value = (value | (value >> 4)) & 0x00ff00ff00ff00ffull;
+    value = (value | (value >> 8)) & 0x0000ffff0000ffffull;
+    value = (value | (value >> 16)) & 0x00000000ffffffffull;
+    return value;
+  }
+
+  // Z-order index of a point with non-negative coordinates. Neighbouring cells of both
+  // rows and columns stay close in memory, which suits grid walks jumping between rows.
+  constexpr uint64_t ToMortonIndex(const Point &p)
+  {
+    return SpreadBits(static_cast<uint32_t>(p.column)) | (SpreadBits(static_cast<uint32_t>(p.row)) << 1);
+  }
+
+  constexpr Point FromMortonIndex(uint64_t index)
+  {
+    return {static_cast<int>(CompactBits(index >> 1)), static_cast<int>(CompactBits(index))};
+  }
+
+  // Number of cells a Morton ordered buffer needs to hold a rows x columns grid. This
+  // is the index of the far corner, which grows with the square of the longer side,
+  // so it only suits grids that are close to square. See GridLayout.
+  constexpr size_t MortonSize(int rows, int columns)
+  {
+    if (rows <= 0 || columns <= 0)
+    {
+      return 0;
+    }
+    return ToMortonIndex({rows - 1, columns - 1}) + 1;
+  }
+
+  // Buffer order for a rows x columns grid: Morton order while it wastes at most three
+  // cells per grid cell, row-major order for elongated grids.
+  class GridLayout
+  {
+  public:
+    constexpr GridLayout(int rows, int columns_)
+        : columns(columns_),
+          size(static_cast<size_t>(std::max(rows, 0)) * static_cast<size_t>(std::max(columns_, 0))),
+          morton(MortonSize(rows, columns_) <= 4 * size)
+    {
+      size = morton ? MortonSize(rows, columns_) : size;
+    }
+
+    constexpr size_t Size() const
+    {
+      return size;
+    }
+
+    constexpr size_t ToIndex(const Point &p) const
+    {
+      return morton ? ToMortonIndex(p) : ToRowMajorIndex(p, columns);
+    }
+
+    constexpr Point FromIndex(size_t index) const
+    {
+      return morton ? FromMortonIndex(index) : FromRowMajorIndex(index, columns);
+    }
+
+  private:
+    int columns;
+    size_t size;
+    bool morton;
+  };
+
+  static_assert(ToMortonIndex({0, 0}) == 0);
+  static_assert(ToMortonIndex({0, 1}) == 1);
+  static_assert(ToMortonIndex({1, 0}) == 2);
+  static_assert(ToMortonIndex({1, 1}) == 3);
+  static_assert(FromMortonIndex(ToMortonIndex({1234, 567})) == Point{1234, 567});
+  static_assert(Point{2, 3}.Neighbour(Direction::Up) == Point{1, 3});
+  static_assert(GridLayout(100, 100).Size() == MortonSize(100, 100));
+  static_assert(GridLayout(1, 1000).Size() == 1000);
+  static_assert(GridLayout(1, 1000).FromIndex(GridLayout(1, 1000).ToIndex({0, 999})) == Point{0, 999});
+}
+
+namespace std
+{
+  template <>
+  struct hash<aoc::Point>
+  {
+    size_t operator()(const aoc::Point &p) const
+    {
+      size_t h1 = std::hash<int>{}(p.row);
+      size_t h2 = std::hash<int>{}(p.column);
+
+      return h1 ^ (h2 << 1);
+    }
+  };
+}
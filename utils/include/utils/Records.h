@@ -0,0 +1,69 @@
+#pragma once
+
+#include <utils/Generator.h>
+#include <algorithm>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+inline std::string ReadBuffer(std::istream &input)
+{
+  return {std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+}
+
+// Yields every line of the buffer without its trailing newline.
+inline Generator<std::string_view> Lines(std::string_view buffer)
+{
+  while (!buffer.empty())
+  {
+    const auto end = buffer.find('\n');
+    co_yield buffer.substr(0, end);
+
+    if (end == std::string_view::npos)
+    {
+      break;
+    }
+    buffer.remove_prefix(end + 1);
+  }
+}
+
+// Yields groups of consecutive non-empty lines, as used by inputs listing records
+// separated by blank lines.
+inline Generator<std::string_view> Blocks(std::string_view buffer)
+{
+  size_t begin = std::string_view::npos;
+  size_t position = 0;
+
+  for (const auto line : Lines(buffer))
+  {
+    if (line.empty())
+    {
+      if (begin != std::string_view::npos)
+      {
+        co_yield buffer.substr(begin, position - 1 - begin);
+        begin = std::string_view::npos;
+      }
+    }
+    else if (begin == std::string_view::npos)
+    {
+      begin = position;
+    }
+    position += line.size() + 1;
+  }
+
+  if (begin != std::string_view::npos)
+  {
+    co_yield buffer.substr(begin, std::min(position - 1, buffer.size()) - begin);
+  }
+}
+
+// Lazily decodes every record of the buffer with the given parser.
+template <typename Record, typename Parser>
+Generator<Record> ParseRecords(Generator<std::string_view> records, Parser parser)
+{
+  for (const auto record : records)
+  {
+    co_yield parser(record);
+  }
+}
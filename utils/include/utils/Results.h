@@ -0,0 +1,178 @@
+#pragma once
+
+#include <utils/AllocationCounter.h>
+#include <utils/MemoCache.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Results are printed as text unless AOC_RESULT_FORMAT=json is set, in which case
+// every answer is emitted as a single JSON line together with its metrics. The test
+// runner also prints to stdout, so AOC_RESULT_FILE names a file the JSON lines are
+// appended to instead, leaving it a clean JSON-lines stream.
+enum class ResultFormat
+{
+  Text,
+  Json
+};
+
+inline ResultFormat GetResultFormat()
+{
+  const char *format = std::getenv("AOC_RESULT_FORMAT");
+  return format != nullptr && std::string_view(format) == "json" ? ResultFormat::Json : ResultFormat::Text;
+}
+
+// Writes one result line to AOC_RESULT_FILE in JSON mode when it is set, otherwise
+// to stdout.
+inline void WriteResultLine(const std::string &line)
+{
+  if (GetResultFormat() == ResultFormat::Json)
+  {
+    if (const char *path = std::getenv("AOC_RESULT_FILE"))
+    {
+      std::ofstream output(path, std::ios::app);
+      if (output.is_open())
+      {
+        output << line << std::endl;
+        return;
+      }
+    }
+  }
+  std::cout << line << std::endl;
+}
+
+// FNV-1a of the whole input file, zero when it cannot be read.
+inline uint64_t HashInput(const std::string &path)
+{
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open())
+  {
+    return 0;
+  }
+
+  uint64_t hash = 14695981039346656037ull;
+  char buffer[4096];
+  while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0)
+  {
+    for (std::streamsize i = 0; i < input.gcount(); ++i)
+    {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
+// Escapes quotes, backslashes and control characters, so any text is a valid JSON
+// string body.
+inline std::string EscapeJson(std::string_view text)
+{
+  constexpr std::string_view hexDigits = "0123456789abcdef";
+
+  std::string escaped;
+  for (const char c : text)
+  {
+    switch (c)
+    {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\r':
+      escaped += "\\r";
+      break;
+    case '\t':
+      escaped += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        escaped += "\\u00";
+        escaped += hexDigits[static_cast<unsigned char>(c) >> 4];
+        escaped += hexDigits[static_cast<unsigned char>(c) & 0xf];
+      }
+      else
+      {
+        escaped += c;
+      }
+    }
+  }
+  return escaped;
+}
+
+template <typename T>
+void WriteJsonValue(std::ostream &output, const T &value)
+{
+  if constexpr (std::is_arithmetic_v<T>)
+  {
+    output << value;
+  }
+  else
+  {
+    std::ostringstream text;
+    text << value;
+    output << '"' << EscapeJson(text.str()) << '"';
+  }
+}
+
+template <typename Solver>
+void ReportResult(int day, int part, Solver &&solver, const std::string &inputPath = "data.txt")
+{
+  const auto allocationsBefore = GetAllocationStats();
+  const auto startTime = std::chrono::high_resolution_clock::now();
+
+  const auto answer = solver();
+
+  const auto endTime = std::chrono::high_resolution_clock::now();
+  const auto allocations = GetAllocationStats() - allocationsBefore;
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+  std::ostringstream line;
+  if (GetResultFormat() == ResultFormat::Text)
+  {
+    line << "Day " << day << " - part " << part << " result: " << answer;
+    WriteResultLine(line.str());
+    return;
+  }
+
+  line << "{\"day\":" << day
+       << ",\"part\":" << part
+       << ",\"answer\":";
+  WriteJsonValue(line, answer);
+  line << ",\"time_us\":" << duration
+       << ",\"allocations\":" << allocations.count
+       << ",\"allocated_bytes\":" << allocations.bytes
+       << ",\"input_hash\":\"" << std::hex << HashInput(inputPath) << std::dec << "\"}";
+
+  WriteResultLine(line.str());
+}
+
+inline void ReportCacheStats(int day, const std::string &name, const CacheStats &stats)
+{
+  std::ostringstream line;
+  if (GetResultFormat() == ResultFormat::Text)
+  {
+    line << "Day " << day << " - " << name << " cache: " << stats;
+    WriteResultLine(line.str());
+    return;
+  }
+
+  line << "{\"day\":" << day
+       << ",\"cache\":\"" << EscapeJson(name) << '"'
+       << ",\"hits\":" << stats.hits
+       << ",\"misses\":" << stats.misses
+       << ",\"evictions\":" << stats.evictions
+       << ",\"size\":" << stats.size << '}';
+  WriteResultLine(line.str());
+}
@@ -0,0 +1,23 @@
+#include <catch2/catch_all.hpp>
+#include <utils/Results.h>
+#include <sstream>
+#include <string>
+
+TEST_CASE("Escape JSON strings")
+{
+  REQUIRE(EscapeJson("plain text") == "plain text");
+  REQUIRE(EscapeJson("a\"b\\c") == R"(a\"b\\c)");
+  REQUIRE(EscapeJson("two\nlines\r\tend") == R"(two\nlines\r\tend)");
+  REQUIRE(EscapeJson(std::string("\x01\x1f", 2)) == R"(\u0001\u001f)");
+}
+
+TEST_CASE("Write JSON values")
+{
+  std::ostringstream number;
+  WriteJsonValue(number, 1234567890123ull);
+  REQUIRE(number.str() == "1234567890123");
+
+  std::ostringstream text;
+  WriteJsonValue(text, std::string("12,3\n\"x\""));
+  REQUIRE(text.str() == R"("12,3\n\"x\"")");
+}